@@ -0,0 +1,91 @@
+#include "bench.hpp"
+
+#include <zstring_arena.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Keeping null-terminated copies of the fields of a parsed request (slices of a larger buffer): a std::string per
+// field allocates whenever a field is too long for the small string buffer, a per-request arena doesn't allocate once
+// it has warmed up.
+
+namespace {
+    constexpr std::size_t fields_per_request = 16;
+    constexpr std::size_t request_count = 64;
+
+    struct request {
+        std::string buffer;
+        std::vector<std::string_view> fields;
+    };
+
+    std::shared_ptr<const std::vector<request>> make_requests() {
+        auto requests = std::make_shared<std::vector<request>>(request_count);
+        std::uint64_t seed = 0;
+        for(auto& request : *requests) {
+            std::vector<std::size_t> lengths;
+            for(std::size_t i = 0; i < fields_per_request; i++) {
+                // Mostly short fields, some longer than the small string buffer
+                lengths.push_back(4 + (seed * 7 + i * 13) % 48);
+                request.buffer += bench::random_string<char>(lengths.back(), seed++);
+                request.buffer += ';';
+            }
+            std::string_view buffer = request.buffer;
+            for(auto length : lengths) {
+                request.fields.push_back(buffer.substr(0, length));
+                buffer.remove_prefix(length + 1);
+            }
+        }
+        return requests;
+    }
+
+    void register_arena() {
+        auto requests = make_requests();
+        std::size_t bytes = 0;
+        for(const auto& request : *requests) {
+            bytes += request.buffer.size();
+        }
+        bytes /= request_count;
+
+        bench::add("arena/char/std::string per field", bytes, [requests](std::size_t iterations) {
+            std::vector<std::string> fields;
+            fields.reserve(fields_per_request);
+            for(std::size_t i = 0; i < iterations; i++) {
+                fields.clear();
+                for(auto field : (*requests)[i % request_count].fields) {
+                    fields.emplace_back(field);
+                }
+                bench::do_not_optimize(fields.back().c_str());
+            }
+        });
+        bench::add("arena/char/zstring_arena store", bytes, [requests](std::size_t iterations) {
+            std::zstring_arena arena;
+            std::vector<std::zstring_view> fields;
+            fields.reserve(fields_per_request);
+            for(std::size_t i = 0; i < iterations; i++) {
+                arena.reset();
+                fields.clear();
+                for(auto field : (*requests)[i % request_count].fields) {
+                    fields.push_back(arena.store(field));
+                }
+                bench::do_not_optimize(fields.back().c_str());
+            }
+        });
+        bench::add("arena/char/zstring_arena store (deduplicating)", bytes, [requests](std::size_t iterations) {
+            std::zstring_arena arena(std::zstring_arena::default_chunk_size, true);
+            std::vector<std::zstring_view> fields;
+            fields.reserve(fields_per_request);
+            for(std::size_t i = 0; i < iterations; i++) {
+                arena.reset();
+                fields.clear();
+                for(auto field : (*requests)[i % request_count].fields) {
+                    fields.push_back(arena.store(field));
+                }
+                bench::do_not_optimize(fields.back().c_str());
+            }
+        });
+    }
+
+    const bool registered = (register_arena(), true);
+}
@@ -0,0 +1,86 @@
+#ifndef ZSTRING_VIEW_BENCH_HPP
+#define ZSTRING_VIEW_BENCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bench {
+    // Keeps the optimizer from discarding a value that is otherwise unused
+    template<typename T>
+    inline void do_not_optimize(const T& value) {
+        #if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+        #else
+        static volatile char sink;
+        sink = *reinterpret_cast<const volatile char*>(&value);
+        #endif
+    }
+
+    // Makes the optimizer forget what it knows about a value, e.g. so a length scan can't be hoisted out of a loop
+    template<typename T>
+    inline void launder(T& value) {
+        #if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : "+r,m"(value) : : "memory");
+        #else
+        do_not_optimize(value);
+        #endif
+    }
+
+    // Number of calls to the global operator new so far (defined in main.cpp, which replaces it)
+    std::size_t allocation_count() noexcept;
+
+    // A benchmark body performs its operation `iterations` times
+    using body = std::function<void(std::size_t iterations)>;
+
+    struct benchmark {
+        std::string name;
+        // Bytes processed by one iteration, used to report throughput; 0 if throughput isn't meaningful
+        std::size_t bytes_per_iteration;
+        body run;
+    };
+
+    inline std::vector<benchmark>& registry() {
+        static std::vector<benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    inline void add(std::string name, std::size_t bytes_per_iteration, body run) {
+        registry().push_back({std::move(name), bytes_per_iteration, std::move(run)});
+    }
+
+    // Invokes f.template operator()<charT>(name) for each of the five character types with a zstring_view typedef
+    template<typename F>
+    void for_each_char_type(F&& f) {
+        f.template operator()<char>("char");
+        f.template operator()<char8_t>("char8_t");
+        f.template operator()<char16_t>("char16_t");
+        f.template operator()<char32_t>("char32_t");
+        f.template operator()<wchar_t>("wchar_t");
+    }
+
+    // Deterministic pseudo-random text drawn from [lo, hi]
+    template<typename charT>
+    std::basic_string<charT> random_string(std::size_t length, std::uint64_t seed, char lo = 'a', char hi = 'z') {
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<int> dist(lo, hi);
+        std::basic_string<charT> str(length, charT());
+        for(auto& c : str) {
+            c = static_cast<charT>(dist(rng));
+        }
+        return str;
+    }
+
+    // Widens a narrow ASCII string to any character type
+    template<typename charT>
+    std::basic_string<charT> widen(std::string_view str) {
+        return std::basic_string<charT>(str.begin(), str.end());
+    }
+}
+
+#endif
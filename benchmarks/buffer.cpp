@@ -0,0 +1,59 @@
+#include "bench.hpp"
+
+#include <zstring_buffer.hpp>
+
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <sys/stat.h>
+
+// Passing a string_view path to stat(): std::string(sv).c_str() versus c_str_of(sv). The paths are sliced out of a
+// larger string so they aren't terminated. The "copy" variants leave out the syscall to show the cost of the
+// conversion alone.
+
+namespace {
+    constexpr std::size_t path_lengths[] = {12, 48, 400};
+
+    void register_buffer() {
+        for(auto length : path_lengths) {
+            auto prefix = std::format("buffer/char/{}/", length);
+            // A path to a file that doesn't exist, followed by more text
+            auto text = std::make_shared<const std::string>(
+                "/tmp/" + bench::random_string<char>(length - 5, length) + ":/usr/bin"
+            );
+            auto path = [text, length] {
+                std::string_view path = std::string_view(*text).substr(0, length);
+                bench::launder(path);
+                return path;
+            };
+            bench::add(prefix + "stat(std::string(sv).c_str())", length, [path](std::size_t iterations) {
+                struct stat info;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::do_not_optimize(::stat(std::string(path()).c_str(), &info));
+                }
+            });
+            bench::add(prefix + "stat(c_str_of(sv).c_str())", length, [path](std::size_t iterations) {
+                struct stat info;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::do_not_optimize(::stat(std::c_str_of(path()).c_str(), &info));
+                }
+            });
+            bench::add(prefix + "copy std::string(sv)", length, [path](std::size_t iterations) {
+                for(std::size_t i = 0; i < iterations; i++) {
+                    std::string str(path());
+                    bench::do_not_optimize(str.c_str());
+                }
+            });
+            bench::add(prefix + "copy c_str_of(sv)", length, [path](std::size_t iterations) {
+                for(std::size_t i = 0; i < iterations; i++) {
+                    auto str = std::c_str_of(path());
+                    bench::do_not_optimize(str.c_str());
+                }
+            });
+        }
+    }
+
+    const bool registered = (register_buffer(), true);
+}
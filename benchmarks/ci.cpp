@@ -0,0 +1,99 @@
+#include "bench.hpp"
+
+#include <ci_char_traits.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <strings.h>
+
+// Case-insensitive equality, search and hashing: a per-character tolower loop and strcasecmp versus ci_zstring_view,
+// and hashing a lowercased copy versus std::hash<ci_zstring_view>. The strings differ only in case.
+
+namespace {
+    constexpr std::size_t lengths[] = {16, 64, 1024};
+
+    bool tolower_equal(std::string_view x, std::string_view y) {
+        return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin(), [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        });
+    }
+
+    void register_ci() {
+        for(auto length : lengths) {
+            auto prefix = std::format("ci/char/{}/", length);
+            auto lower = std::make_shared<const std::string>(bench::random_string<char>(length, length, 'a', 'z'));
+            auto mixed = std::make_shared<std::string>(*lower);
+            for(std::size_t i = 0; i < mixed->size(); i += 3) {
+                (*mixed)[i] = static_cast<char>(std::toupper(static_cast<unsigned char>((*mixed)[i])));
+            }
+            bench::add(prefix + "tolower loop ==", length * 2, [lower, mixed](std::size_t iterations) {
+                std::string_view x = *lower;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(x);
+                    bench::do_not_optimize(tolower_equal(x, *mixed));
+                }
+            });
+            bench::add(prefix + "strcasecmp", length * 2, [lower, mixed](std::size_t iterations) {
+                const char* x = lower->c_str();
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(x);
+                    bench::do_not_optimize(::strcasecmp(x, mixed->c_str()));
+                }
+            });
+            bench::add(prefix + "ci_zstring_view ==", length * 2, [lower, mixed](std::size_t iterations) {
+                std::ci_zstring_view x(lower->c_str(), lower->size());
+                const std::ci_zstring_view y(mixed->c_str(), mixed->size());
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(x);
+                    bench::do_not_optimize(x == y);
+                }
+            });
+            // The needle only occurs at the end
+            auto haystack = std::make_shared<std::string>(*mixed);
+            std::replace(haystack->begin(), haystack->end(), 'Q', 'R');
+            std::replace(haystack->begin(), haystack->end(), 'q', 'r');
+            haystack->back() = 'Q';
+            bench::add(prefix + "tolower loop find", length, [haystack](std::size_t iterations) {
+                std::string_view x = *haystack;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(x);
+                    bench::do_not_optimize(std::find_if(x.begin(), x.end(), [](char c) {
+                        return std::tolower(static_cast<unsigned char>(c)) == 'q';
+                    }));
+                }
+            });
+            bench::add(prefix + "ci_zstring_view find", length, [haystack](std::size_t iterations) {
+                std::ci_zstring_view x(haystack->c_str(), haystack->size());
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(x);
+                    bench::do_not_optimize(x.find('q'));
+                }
+            });
+            bench::add(prefix + "hash lowercased copy", length, [mixed](std::size_t iterations) {
+                std::string_view x = *mixed;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(x);
+                    std::string copy(x);
+                    for(auto& c : copy) {
+                        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                    }
+                    bench::do_not_optimize(std::hash<std::string>{}(copy));
+                }
+            });
+            bench::add(prefix + "hash<ci_zstring_view>", length, [mixed](std::size_t iterations) {
+                std::ci_zstring_view x(mixed->c_str(), mixed->size());
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(x);
+                    bench::do_not_optimize(std::hash<std::ci_zstring_view>{}(x));
+                }
+            });
+        }
+    }
+
+    const bool registered = (register_ci(), true);
+}
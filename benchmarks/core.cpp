@@ -0,0 +1,140 @@
+#include "bench.hpp"
+
+#include <zstring_view.hpp>
+
+#include <format>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+// Baseline numbers for the basic_zstring_view operations that show up in hot paths, plus the
+// string_view -> std::string -> c_str() round trip that zstring_view exists to replace.
+
+namespace {
+    constexpr std::size_t lengths[] = {16, 256, 4096};
+
+    // Stands in for a C API taking a null-terminated string
+    template<typename charT>
+    [[gnu::noinline]] std::size_t c_api(const charT* str) {
+        bench::do_not_optimize(str);
+        return str[0] != charT();
+    }
+
+    template<typename charT>
+    void register_core(std::string_view type) {
+        using zsv = std::basic_zstring_view<charT>;
+        using sv = std::basic_string_view<charT>;
+
+        for(auto length : lengths) {
+            auto prefix = std::format("core/{}/{}/", type, length);
+            // The needle and set members sit at the end so every search covers the whole string
+            auto text = bench::random_string<charT>(length, length) + bench::widen<charT>("/x.y");
+            auto other = text;
+            other.back() = charT('z');
+            auto bytes = text.size() * sizeof(charT);
+
+            bench::add(prefix + "construct(const charT*)", bytes, [text](std::size_t iterations) {
+                const charT* str = text.c_str();
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(str);
+                    zsv view = str;
+                    bench::do_not_optimize(view.size());
+                }
+            });
+            bench::add(prefix + "find(charT)", bytes, [text](std::size_t iterations) {
+                zsv view = text;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(view);
+                    bench::do_not_optimize(view.find(charT('.')));
+                }
+            });
+            bench::add(prefix + "find(string_view)", bytes, [text](std::size_t iterations) {
+                zsv view = text;
+                auto needle = bench::widen<charT>("x.y");
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(view);
+                    bench::do_not_optimize(view.find(sv(needle)));
+                }
+            });
+            bench::add(prefix + "find_first_of", bytes, [text](std::size_t iterations) {
+                zsv view = text;
+                auto set = bench::widen<charT>("/.\\:");
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(view);
+                    bench::do_not_optimize(view.find_first_of(sv(set)));
+                }
+            });
+            bench::add(prefix + "find_first_not_of", bytes, [text](std::size_t iterations) {
+                zsv view = text;
+                auto set = bench::widen<charT>("abcdefghijklmnopqrstuvwxyz");
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(view);
+                    bench::do_not_optimize(view.find_first_not_of(sv(set)));
+                }
+            });
+            bench::add(prefix + "compare", bytes, [text, other](std::size_t iterations) {
+                zsv x = text;
+                zsv y = other;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(x);
+                    bench::do_not_optimize(x.compare(y));
+                }
+            });
+            bench::add(prefix + "operator<=>", bytes, [text, other](std::size_t iterations) {
+                zsv x = text;
+                zsv y = other;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(x);
+                    bench::do_not_optimize(x <=> y);
+                }
+            });
+            bench::add(prefix + "hash", bytes, [text](std::size_t iterations) {
+                zsv view = text;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(view);
+                    bench::do_not_optimize(std::hash<zsv>{}(view));
+                }
+            });
+            // std::formatter<basic_string_view> only exists for char and wchar_t
+            if constexpr(std::is_same_v<charT, char> || std::is_same_v<charT, wchar_t>) {
+                bench::add(prefix + "format", bytes, [text](std::size_t iterations) {
+                    zsv view = text;
+                    std::basic_string<charT> out;
+                    out.reserve(text.size());
+                    static constexpr charT fmt[] = {'{', '}', 0};
+                    for(std::size_t i = 0; i < iterations; i++) {
+                        out.clear();
+                        bench::launder(view);
+                        std::format_to(std::back_inserter(out), fmt, view);
+                        bench::do_not_optimize(out.data());
+                    }
+                });
+            }
+
+            // Getting a C string out of something that might not be null-terminated
+            bench::add(prefix + "c_api(std::string(string_view).c_str())", bytes, [text](std::size_t iterations) {
+                sv view = text;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(view);
+                    std::basic_string<charT> copy(view);
+                    bench::do_not_optimize(c_api(copy.c_str()));
+                }
+            });
+            bench::add(prefix + "c_api(zstring_view.c_str())", bytes, [text](std::size_t iterations) {
+                zsv view = text;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::launder(view);
+                    bench::do_not_optimize(c_api(view.c_str()));
+                }
+            });
+        }
+    }
+
+    const bool registered = [] {
+        bench::for_each_char_type([]<typename charT>(std::string_view type) {
+            register_core<charT>(type);
+        });
+        return true;
+    }();
+}
@@ -0,0 +1,84 @@
+#include "bench.hpp"
+
+#include <zstring_view.hpp>
+
+#include <format>
+#include <string>
+#include <string_view>
+
+// The sentinel-based search members of basic_zstring_view against the basic_string_view members they used to forward
+// to, on the kind of inputs they see in practice: long paths and log lines.
+
+namespace {
+    struct input {
+        std::string_view name;
+        std::string text;
+    };
+
+    std::string long_path() {
+        std::string path;
+        for(int i = 0; i < 24; i++) {
+            path += "/component_" + std::to_string(i);
+        }
+        return path + "/file.tar.gz";
+    }
+
+    std::string log_line() {
+        return "2024-05-17T12:34:56.789Z host-1234 service[5678]: "
+               + std::string(200, 'x')
+               + " request completed status=200 latency_ms=12";
+    }
+
+    template<typename charT, typename F>
+    void add_pair(const std::string& prefix, std::string_view operation, const std::basic_string<charT>& text, F f) {
+        auto bytes = text.size() * sizeof(charT);
+        bench::add(prefix + "string_view::" + std::string(operation), bytes, [text, f](std::size_t iterations) {
+            std::basic_string_view<charT> view = text;
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(view);
+                bench::do_not_optimize(f(view));
+            }
+        });
+        bench::add(prefix + "zstring_view::" + std::string(operation), bytes, [text, f](std::size_t iterations) {
+            std::basic_zstring_view<charT> view = text;
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(view);
+                bench::do_not_optimize(f(view));
+            }
+        });
+    }
+
+    template<typename charT>
+    void register_find(std::string_view type) {
+        const input inputs[] = {{"path", long_path()}, {"log", log_line()}};
+        for(const auto& [name, narrow] : inputs) {
+            auto prefix = std::format("find/{}/{}/", type, name);
+            auto text = bench::widen<charT>(narrow);
+            auto query = bench::widen<charT>("?#");
+            auto separators = bench::widen<charT>("=:");
+            auto word = bench::widen<charT>("abcdefghijklmnopqrstuvwxyz0123456789-/_.[]: ");
+            add_pair<charT>(prefix, "find(charT)", text, [](auto view) {
+                return view.find(charT('='));
+            });
+            add_pair<charT>(prefix, "rfind(charT)", text, [](auto view) {
+                return view.rfind(charT('/'));
+            });
+            add_pair<charT>(prefix, "find_first_of(\"?#\")", text, [query](auto view) {
+                return view.find_first_of(query);
+            });
+            add_pair<charT>(prefix, "find_first_of(\"=:\")", text, [separators](auto view) {
+                return view.find_first_of(separators, 30);
+            });
+            add_pair<charT>(prefix, "find_first_not_of(word)", text, [word](auto view) {
+                return view.find_first_not_of(word);
+            });
+        }
+    }
+
+    const bool registered = [] {
+        bench::for_each_char_type([]<typename charT>(std::string_view type) {
+            register_find<charT>(type);
+        });
+        return true;
+    }();
+}
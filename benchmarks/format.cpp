@@ -0,0 +1,45 @@
+#include "bench.hpp"
+
+#include <format_to_z.hpp>
+
+#include <format>
+#include <memory>
+#include <string>
+
+// Formatting a path for a C API: std::format(...).c_str() versus format_to_z into a stack array and into a
+// zformat_buffer. The zformat_buffer has 64 code units inline, so the longest paths take the heap path.
+
+namespace {
+    constexpr std::size_t name_lengths[] = {8, 32, 200};
+
+    void register_format() {
+        for(auto length : name_lengths) {
+            auto prefix = std::format("format/char/{}/", length);
+            auto name = std::make_shared<const std::string>(bench::random_string<char>(length, length));
+            auto directory = std::make_shared<const std::string>("/var/log/service");
+            const std::size_t bytes = directory->size() + length + 10;
+            bench::add(prefix + "std::format(...).c_str()", bytes, [name, directory](std::size_t iterations) {
+                for(std::size_t i = 0; i < iterations; i++) {
+                    std::string path = std::format("{}/{}.{}.log", *directory, *name, i & 7);
+                    bench::do_not_optimize(path.c_str());
+                }
+            });
+            bench::add(prefix + "format_to_z(char[256])", bytes, [name, directory](std::size_t iterations) {
+                char buffer[256];
+                for(std::size_t i = 0; i < iterations; i++) {
+                    auto path = std::format_to_z(buffer, "{}/{}.{}.log", *directory, *name, i & 7);
+                    bench::do_not_optimize(path.str.c_str());
+                }
+            });
+            bench::add(prefix + "format_to_z(zformat_buffer)", bytes, [name, directory](std::size_t iterations) {
+                std::basic_zformat_buffer<char, 64> buffer;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    auto path = std::format_to_z(buffer, "{}/{}.{}.log", *directory, *name, i & 7);
+                    bench::do_not_optimize(path.c_str());
+                }
+            });
+        }
+    }
+
+    const bool registered = (register_format(), true);
+}
@@ -0,0 +1,59 @@
+#include "bench.hpp"
+
+#include <hashed_zstring_view.hpp>
+
+#include <format>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Repeated lookups of interned keys: basic_zstring_view rehashes the key on every probe, basic_hashed_zstring_view
+// reuses the hash it computed at construction and rejects mismatches by hash before comparing characters.
+
+namespace {
+    constexpr std::size_t key_lengths[] = {16, 64, 256};
+    constexpr std::size_t key_count = 1024;
+
+    void register_hashed() {
+        for(auto length : key_lengths) {
+            auto prefix = std::format("hashed/char/{}/", length);
+            std::vector<std::string> storage;
+            for(std::size_t i = 0; i < key_count; i++) {
+                storage.push_back(bench::random_string<char>(length, i));
+            }
+            auto keys = std::make_shared<const std::vector<std::string>>(std::move(storage));
+            auto bytes = length;
+
+            bench::add(prefix + "unordered_set<zstring_view>::find", bytes, [keys](std::size_t iterations) {
+                std::unordered_set<std::zstring_view> set(keys->begin(), keys->end());
+                std::vector<std::zstring_view> probes(keys->begin(), keys->end());
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::do_not_optimize(set.find(probes[i % key_count]));
+                }
+            });
+            bench::add(prefix + "unordered_set<hashed_zstring_view>::find", bytes, [keys](std::size_t iterations) {
+                std::unordered_set<std::hashed_zstring_view> set(keys->begin(), keys->end());
+                std::vector<std::hashed_zstring_view> probes(keys->begin(), keys->end());
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::do_not_optimize(set.find(probes[i % key_count]));
+                }
+            });
+            bench::add(prefix + "hash<zstring_view>", bytes, [keys](std::size_t iterations) {
+                std::vector<std::zstring_view> probes(keys->begin(), keys->end());
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::do_not_optimize(std::hash<std::zstring_view>{}(probes[i % key_count]));
+                }
+            });
+            bench::add(prefix + "hash<hashed_zstring_view>", bytes, [keys](std::size_t iterations) {
+                std::vector<std::hashed_zstring_view> probes(keys->begin(), keys->end());
+                for(std::size_t i = 0; i < iterations; i++) {
+                    bench::do_not_optimize(std::hash<std::hashed_zstring_view>{}(probes[i % key_count]));
+                }
+            });
+        }
+    }
+
+    const bool registered = (register_hashed(), true);
+}
@@ -0,0 +1,46 @@
+#include "bench.hpp"
+
+#include <lazy_zstring_view.hpp>
+
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// The C callback pattern: a string arrives as a bare pointer and is only checked for a prefix or compared against a
+// constant. basic_zstring_view's pointer constructor scans for the length first, basic_lazy_zstring_view doesn't.
+
+namespace {
+    constexpr std::size_t lengths[] = {16, 256, 4096};
+
+    template<typename View>
+    void add_callback(std::string name, std::size_t length, std::shared_ptr<const std::string> str, auto operation) {
+        bench::add(std::move(name), length, [str, operation](std::size_t iterations) {
+            const char* pointer = str->c_str();
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(pointer);
+                bench::do_not_optimize(operation(View(pointer)));
+            }
+        });
+    }
+
+    void register_lazy() {
+        using namespace std::literals;
+        for(auto length : lengths) {
+            auto prefix = std::format("lazy/char/{}/", length);
+            auto str = std::make_shared<const std::string>("content-type: " + bench::random_string<char>(length - 14, length));
+            auto starts_with = [](auto view) {
+                return view.starts_with("content-type:"sv);
+            };
+            auto equals = [](auto view) {
+                return view == "content-length: 0"sv;
+            };
+            add_callback<std::zstring_view>(prefix + "zstring_view(p).starts_with", length, str, starts_with);
+            add_callback<std::lazy_zstring_view>(prefix + "lazy_zstring_view(p).starts_with", length, str, starts_with);
+            add_callback<std::zstring_view>(prefix + "zstring_view(p) == literal", length, str, equals);
+            add_callback<std::lazy_zstring_view>(prefix + "lazy_zstring_view(p) == literal", length, str, equals);
+        }
+    }
+
+    const bool registered = (register_lazy(), true);
+}
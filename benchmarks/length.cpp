@@ -0,0 +1,60 @@
+#include "bench.hpp"
+
+#include <zstring_view.hpp>
+
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The length scan in basic_zstring_view(const charT*): traits::length versus the SSE2 and AVX2 kernels for 2- and
+// 4-byte code units. Strings start one code unit past a vector boundary to exercise the misaligned head.
+
+namespace {
+    constexpr std::size_t lengths[] = {8, 64, 1024, 65536};
+
+    template<typename charT, typename F>
+    void add_length_benchmark(std::string name, std::size_t length, F length_of) {
+        bench::add(std::move(name), length * sizeof(charT), [length, length_of](std::size_t iterations) {
+            std::vector<charT> buffer(length + 64, charT('a'));
+            const charT* str = buffer.data() + 1;
+            buffer[1 + length] = charT();
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(str);
+                bench::do_not_optimize(length_of(str));
+            }
+        });
+    }
+
+    template<typename charT>
+    void register_length(std::string_view type) {
+        for(auto length : lengths) {
+            auto prefix = std::format("length/{}/{}/", type, length);
+            add_length_benchmark<charT>(prefix + "traits::length", length, [](const charT* str) {
+                return std::char_traits<charT>::length(str);
+            });
+            add_length_benchmark<charT>(prefix + "basic_zstring_view(const charT*)", length, [](const charT* str) {
+                return std::basic_zstring_view<charT>(str).size();
+            });
+            #ifdef ZSTRING_VIEW_X86_SIMD
+            if constexpr(sizeof(charT) == 2 || sizeof(charT) == 4) {
+                add_length_benchmark<charT>(prefix + "sse2", length, [](const charT* str) {
+                    return std::__zsv::__length_sse2<sizeof(charT)>(str);
+                });
+                if(std::__zsv::__detect_avx2()) {
+                    add_length_benchmark<charT>(prefix + "avx2", length, [](const charT* str) {
+                        return std::__zsv::__length_avx2<sizeof(charT)>(str);
+                    });
+                }
+            }
+            #endif
+        }
+    }
+
+    const bool registered = [] {
+        bench::for_each_char_type([]<typename charT>(std::string_view type) {
+            register_length<charT>(type);
+        });
+        return true;
+    }();
+}
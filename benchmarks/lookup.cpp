@@ -0,0 +1,57 @@
+#include "bench.hpp"
+
+#include <zstring_hash.hpp>
+
+#include <format>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Probing an unordered_set<std::string> with a zstring_view: std::hash<std::string> needs a temporary std::string per
+// lookup, the transparent zstring_hash/zstring_equal pair doesn't.
+
+namespace {
+    constexpr std::size_t key_lengths[] = {8, 32, 128};
+    constexpr std::size_t key_count = 1024;
+
+    template<typename Set, typename F>
+    void add_lookup(std::string name, std::size_t length, std::shared_ptr<const std::vector<std::string>> keys, F probe) {
+        bench::add(std::move(name), length, [keys, probe](std::size_t iterations) {
+            Set set(keys->begin(), keys->end());
+            std::vector<std::zstring_view> probes(keys->begin(), keys->end());
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::do_not_optimize(probe(set, probes[i % key_count]));
+            }
+        });
+    }
+
+    void register_lookup() {
+        for(auto length : key_lengths) {
+            auto prefix = std::format("lookup/char/{}/", length);
+            std::vector<std::string> storage;
+            for(std::size_t i = 0; i < key_count; i++) {
+                storage.push_back(bench::random_string<char>(length, i));
+            }
+            auto keys = std::make_shared<const std::vector<std::string>>(std::move(storage));
+
+            using std_set = std::unordered_set<std::string>;
+            using transparent_set = std::unordered_set<std::string, std::zstring_hash, std::zstring_equal>;
+            using fast_set = std::unordered_set<std::string, std::zstring_fast_hash, std::zstring_equal>;
+            add_lookup<std_set>(prefix + "std::hash find(std::string(zsv))", length, keys, [](auto& set, auto key) {
+                return set.find(std::string(key)) != set.end();
+            });
+            add_lookup<transparent_set>(prefix + "zstring_hash find(zsv)", length, keys, [](auto& set, auto key) {
+                return set.find(key) != set.end();
+            });
+            add_lookup<transparent_set>(prefix + "zstring_hash find(zsv.c_str())", length, keys, [](auto& set, auto key) {
+                return set.find(key.c_str()) != set.end();
+            });
+            add_lookup<fast_set>(prefix + "zstring_fast_hash find(zsv)", length, keys, [](auto& set, auto key) {
+                return set.find(key) != set.end();
+            });
+        }
+    }
+
+    const bool registered = (register_lookup(), true);
+}
@@ -0,0 +1,102 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <print>
+#include <string_view>
+
+namespace {
+    std::atomic<std::size_t> allocations{0};
+}
+
+std::size_t bench::allocation_count() noexcept {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+// Count allocations so benchmarks can report allocations per operation
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if(void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr auto min_sample_time = std::chrono::milliseconds(20);
+    constexpr int samples = 5;
+
+    double time_ns(const bench::body& run, std::size_t iterations) {
+        auto start = clock_type::now();
+        run(iterations);
+        auto stop = clock_type::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+
+    // Grows the iteration count until one sample takes at least min_sample_time
+    std::size_t calibrate(const bench::body& run) {
+        const double target = std::chrono::duration<double, std::nano>(min_sample_time).count();
+        std::size_t iterations = 1;
+        while(true) {
+            double elapsed = time_ns(run, iterations);
+            if(elapsed >= target || iterations >= (std::size_t(1) << 40)) {
+                return iterations;
+            }
+            double scale = elapsed > 0 ? target / elapsed * 1.2 : 10;
+            iterations = std::max(iterations * 2, static_cast<std::size_t>(iterations * std::min(scale, 100.0)));
+        }
+    }
+}
+
+// Usage: benchmarks [filter...]
+// Runs every registered benchmark whose name contains any of the filters (all of them if none are given) and
+// reports the best of several samples.
+int main(int argc, char** argv) {
+    std::vector<std::string_view> filters(argv + 1, argv + argc);
+    std::println("{:<64} {:>14} {:>12} {:>10}", "benchmark", "ns/op", "MB/s", "allocs/op");
+    for(const auto& benchmark : bench::registry()) {
+        if(
+            !filters.empty()
+            && std::none_of(filters.begin(), filters.end(), [&](std::string_view filter) {
+                return benchmark.name.find(filter) != std::string::npos;
+            })
+        ) {
+            continue;
+        }
+        auto iterations = calibrate(benchmark.run);
+        auto allocations_before = bench::allocation_count();
+        double best = time_ns(benchmark.run, iterations);
+        // Includes any setup the body does, which is amortized over the iterations
+        double allocs_per_op = double(bench::allocation_count() - allocations_before) / iterations;
+        for(int i = 1; i < samples; i++) {
+            best = std::min(best, time_ns(benchmark.run, iterations));
+        }
+        double ns_per_op = best / iterations;
+        if(benchmark.bytes_per_iteration) {
+            double mb_per_s = benchmark.bytes_per_iteration / ns_per_op * 1e9 / 1e6;
+            std::println("{:<64} {:>14.2f} {:>12.1f} {:>10.2f}", benchmark.name, ns_per_op, mb_per_s, allocs_per_op);
+        } else {
+            std::println("{:<64} {:>14.2f} {:>12} {:>10.2f}", benchmark.name, ns_per_op, "-", allocs_per_op);
+        }
+    }
+}
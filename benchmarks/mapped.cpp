@@ -0,0 +1,79 @@
+#include "bench.hpp"
+
+#include <mapped_zfile.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+// Reading a file line by line: std::getline into a std::string versus mapped_zfile::lines(), which yields
+// null-terminated lines straight out of a private mapping, and a read-only scan of view(). All include opening the
+// file.
+
+namespace {
+    constexpr std::size_t file_size = 4 << 20;
+
+    // A log-like file in the temporary directory, removed when the last benchmark using it is destroyed
+    struct temporary_file {
+        std::filesystem::path path;
+
+        temporary_file() : path(std::filesystem::temp_directory_path() / "zstring_view_bench_lines.txt") {
+            std::ofstream file(path, std::ios::binary);
+            std::size_t written = 0;
+            for(std::uint64_t seed = 0; written < file_size; seed++) {
+                auto line = bench::random_string<char>(20 + seed * 37 % 140, seed, ' ', '~');
+                file << line << '\n';
+                written += line.size() + 1;
+            }
+        }
+        ~temporary_file() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+        temporary_file(const temporary_file&) = delete;
+        temporary_file& operator=(const temporary_file&) = delete;
+    };
+
+    void register_mapped() {
+        auto file = std::make_shared<temporary_file>();
+        auto size = std::filesystem::file_size(file->path);
+        bench::add("mapped/char/4MiB/std::getline", size, [file](std::size_t iterations) {
+            for(std::size_t i = 0; i < iterations; i++) {
+                std::ifstream stream(file->path, std::ios::binary);
+                std::string line;
+                std::size_t total = 0;
+                while(std::getline(stream, line)) {
+                    total += line.size();
+                    bench::do_not_optimize(line.c_str());
+                }
+                bench::do_not_optimize(total);
+            }
+        });
+        bench::add("mapped/char/4MiB/mapped_zfile::view line scan", size, [file](std::size_t iterations) {
+            for(std::size_t i = 0; i < iterations; i++) {
+                std::mapped_zfile mapped(file->path.c_str());
+                auto view = mapped.view();
+                std::size_t lines = 0;
+                for(std::size_t pos = 0; (pos = view.find('\n', pos)) != view.npos; pos++) {
+                    lines++;
+                }
+                bench::do_not_optimize(lines);
+            }
+        });
+        bench::add("mapped/char/4MiB/mapped_zfile::lines", size, [file](std::size_t iterations) {
+            for(std::size_t i = 0; i < iterations; i++) {
+                std::mapped_zfile mapped(file->path.c_str());
+                std::size_t total = 0;
+                for(auto line : mapped.lines()) {
+                    total += line.size();
+                    bench::do_not_optimize(line.c_str());
+                }
+                bench::do_not_optimize(total);
+            }
+        });
+    }
+
+    const bool registered = (register_mapped(), true);
+}
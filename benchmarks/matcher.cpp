@@ -0,0 +1,151 @@
+#include "bench.hpp"
+
+#include <zstring_matcher.hpp>
+
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Matching one haystack against many patterns: zstring_matcher's single pass versus a loop of contains, starts_with
+// or find over the patterns. The keyword cases scan 4 KiB of log text for 100 or 500 alert keywords that don't occur
+// in it (the common case for alerting), and for 100 that do; the routing case finds the longest of 300 route prefixes
+// that each request path starts with.
+
+namespace {
+    constexpr std::size_t log_size = 4096;
+
+    std::vector<std::string> make_keywords(std::size_t count, std::uint64_t seed) {
+        std::vector<std::string> keywords;
+        for(std::size_t i = 0; i < count; i++) {
+            keywords.push_back(bench::random_string<char>(6 + i % 6, seed + i));
+        }
+        return keywords;
+    }
+
+    // Random words of six letters or more are practically never in the random log text unless planted
+    std::string make_log(const std::vector<std::string>& planted) {
+        std::string log;
+        for(std::size_t i = 0; log.size() < log_size; i++) {
+            log += std::format("2024-05-01T12:00:{:02} worker[{}] ", i % 60, i % 7);
+            log += bench::random_string<char>(60, i, 'a', 'z');
+            if(!planted.empty() && i % 4 == 0) {
+                log += " " + planted[i % planted.size()];
+            }
+            log += '\n';
+        }
+        log.resize(log_size);
+        return log;
+    }
+
+    void add_keywords(std::size_t count, bool present) {
+        auto keywords = std::make_shared<const std::vector<std::string>>(make_keywords(count, count));
+        auto log = std::make_shared<const std::string>(make_log(present ? *keywords : std::vector<std::string>{}));
+        auto matcher = std::make_shared<const std::zstring_matcher>(*keywords);
+        const std::string prefix = std::format("matcher/keywords/{}/{}/", count, present ? "present" : "absent");
+
+        bench::add(prefix + "contains loop", log_size, [keywords, log](std::size_t iterations) {
+            std::vector<std::zstring_view> patterns(keywords->begin(), keywords->end());
+            std::zstring_view haystack = *log;
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(haystack);
+                bool found = false;
+                for(std::zstring_view pattern : patterns) {
+                    if(haystack.contains(pattern)) {
+                        found = true;
+                        break;
+                    }
+                }
+                bench::do_not_optimize(found);
+            }
+        });
+        bench::add(prefix + "contains_any", log_size, [log, matcher](std::size_t iterations) {
+            std::zstring_view haystack = *log;
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(haystack);
+                bench::do_not_optimize(matcher->contains_any(haystack));
+            }
+        });
+        if(!present) {
+            return;
+        }
+        bench::add(prefix + "find loop (all)", log_size, [keywords, log](std::size_t iterations) {
+            std::vector<std::zstring_view> patterns(keywords->begin(), keywords->end());
+            std::zstring_view haystack = *log;
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(haystack);
+                std::size_t matches = 0;
+                for(std::zstring_view pattern : patterns) {
+                    for(auto at = haystack.find(pattern); at != std::zstring_view::npos; at = haystack.find(pattern, at + 1)) {
+                        matches++;
+                    }
+                }
+                bench::do_not_optimize(matches);
+            }
+        });
+        bench::add(prefix + "for_each_match", log_size, [log, matcher](std::size_t iterations) {
+            std::zstring_view haystack = *log;
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(haystack);
+                std::size_t matches = 0;
+                matcher->for_each_match(haystack, [&](const std::zstring_match&) {
+                    matches++;
+                });
+                bench::do_not_optimize(matches);
+            }
+        });
+    }
+
+    void add_routes() {
+        auto routes = std::make_shared<std::vector<std::string>>();
+        for(std::size_t i = 0; i < 100; i++) {
+            const std::string base = "/" + bench::random_string<char>(4 + i % 5, i);
+            routes->push_back(base + "/");
+            routes->push_back(base + "/v2/");
+            routes->push_back(base + "/v2/" + bench::random_string<char>(6, i + 1000) + "/");
+        }
+        auto paths = std::make_shared<std::vector<std::string>>();
+        std::size_t bytes = 0;
+        for(std::size_t i = 0; i < 64; i++) {
+            paths->push_back((*routes)[(i * 7) % routes->size()] + bench::random_string<char>(20, i + 2000) + "?page=2");
+            bytes += paths->back().size();
+        }
+        auto matcher = std::make_shared<const std::zstring_matcher>(*routes);
+
+        bench::add("matcher/routes/300/starts_with loop", bytes, [routes, paths](std::size_t iterations) {
+            std::vector<std::zstring_view> patterns(routes->begin(), routes->end());
+            std::vector<std::zstring_view> views(paths->begin(), paths->end());
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(views);
+                for(std::zstring_view path : views) {
+                    std::size_t best = 0;
+                    for(std::zstring_view pattern : patterns) {
+                        if(pattern.size() > best && path.starts_with(pattern)) {
+                            best = pattern.size();
+                        }
+                    }
+                    bench::do_not_optimize(best);
+                }
+            }
+        });
+        bench::add("matcher/routes/300/longest_prefix", bytes, [paths, matcher](std::size_t iterations) {
+            std::vector<std::zstring_view> views(paths->begin(), paths->end());
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(views);
+                for(std::zstring_view path : views) {
+                    bench::do_not_optimize(matcher->longest_prefix(path));
+                }
+            }
+        });
+    }
+
+    void register_matcher() {
+        add_keywords(100, false);
+        add_keywords(500, false);
+        add_keywords(100, true);
+        add_routes();
+    }
+
+    const bool registered = (register_matcher(), true);
+}
@@ -0,0 +1,97 @@
+#include "bench.hpp"
+
+#include <zstring_perfect_map.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Dispatching on one of a fixed set of HTTP header names: zstring_perfect_map versus unordered_map<string_view, int>
+// and a chain of comparisons. Probes are runtime strings, a quarter of them not in the set.
+
+namespace {
+    using namespace std::literals;
+
+    constexpr std::pair<std::zstring_view, int> header_entries[] = {
+        {"accept"zsv, 0}, {"accept-encoding"zsv, 1}, {"accept-language"zsv, 2}, {"authorization"zsv, 3},
+        {"cache-control"zsv, 4}, {"connection"zsv, 5}, {"content-encoding"zsv, 6}, {"content-length"zsv, 7},
+        {"content-type"zsv, 8}, {"cookie"zsv, 9}, {"date"zsv, 10}, {"etag"zsv, 11}, {"expect"zsv, 12},
+        {"host"zsv, 13}, {"if-match"zsv, 14}, {"if-modified-since"zsv, 15}, {"if-none-match"zsv, 16},
+        {"origin"zsv, 17}, {"range"zsv, 18}, {"referer"zsv, 19}, {"transfer-encoding"zsv, 20}, {"upgrade"zsv, 21},
+        {"user-agent"zsv, 22}, {"x-forwarded-for"zsv, 23}
+    };
+    constexpr auto headers = std::make_zstring_perfect_map<int>(header_entries);
+
+    int if_chain(std::string_view name) {
+        if(name == "accept") return 0;
+        if(name == "accept-encoding") return 1;
+        if(name == "accept-language") return 2;
+        if(name == "authorization") return 3;
+        if(name == "cache-control") return 4;
+        if(name == "connection") return 5;
+        if(name == "content-encoding") return 6;
+        if(name == "content-length") return 7;
+        if(name == "content-type") return 8;
+        if(name == "cookie") return 9;
+        if(name == "date") return 10;
+        if(name == "etag") return 11;
+        if(name == "expect") return 12;
+        if(name == "host") return 13;
+        if(name == "if-match") return 14;
+        if(name == "if-modified-since") return 15;
+        if(name == "if-none-match") return 16;
+        if(name == "origin") return 17;
+        if(name == "range") return 18;
+        if(name == "referer") return 19;
+        if(name == "transfer-encoding") return 20;
+        if(name == "upgrade") return 21;
+        if(name == "user-agent") return 22;
+        if(name == "x-forwarded-for") return 23;
+        return -1;
+    }
+
+    std::shared_ptr<const std::vector<std::string>> make_probes() {
+        auto probes = std::make_shared<std::vector<std::string>>();
+        for(const auto& [name, value] : header_entries) {
+            probes->emplace_back(name);
+        }
+        for(std::size_t i = 0; i < std::size(header_entries) / 3; i++) {
+            probes->push_back("x-custom-" + bench::random_string<char>(6, i));
+        }
+        return probes;
+    }
+
+    template<typename F>
+    void add_dispatch(std::string name, std::shared_ptr<const std::vector<std::string>> probes, F lookup) {
+        bench::add(std::move(name), 0, [probes, lookup](std::size_t iterations) {
+            std::vector<std::zstring_view> views(probes->begin(), probes->end());
+            for(std::size_t i = 0; i < iterations; i++) {
+                auto probe = views[i % views.size()];
+                bench::launder(probe);
+                bench::do_not_optimize(lookup(probe));
+            }
+        });
+    }
+
+    void register_perfect_map() {
+        auto probes = make_probes();
+        add_dispatch("perfect_map/char/24 keys/if-chain", probes, [](std::zstring_view probe) {
+            return if_chain(probe);
+        });
+        auto map = std::make_shared<const std::unordered_map<std::string_view, int>>(
+            std::begin(header_entries), std::end(header_entries)
+        );
+        add_dispatch("perfect_map/char/24 keys/unordered_map<string_view, int>", probes, [map](std::zstring_view probe) {
+            auto it = map->find(probe);
+            return it == map->end() ? -1 : it->second;
+        });
+        add_dispatch("perfect_map/char/24 keys/zstring_perfect_map", probes, [](std::zstring_view probe) {
+            const int* value = headers.find(probe);
+            return value ? *value : -1;
+        });
+    }
+
+    const bool registered = (register_perfect_map(), true);
+}
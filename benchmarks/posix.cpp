@@ -0,0 +1,48 @@
+#include "bench.hpp"
+
+#include <zstring_posix.hpp>
+
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Building the argv array for a spawn from strings the launcher already holds: a vector<string> copy plus a
+// vector<char*> of pointers into it, versus a zstring_view_array of pointers to the original strings. Spawning itself
+// is left out, it takes far longer than either and would hide the difference.
+
+namespace {
+    constexpr std::size_t argument_counts[] = {4, 16, 64};
+
+    void register_posix() {
+        for(auto count : argument_counts) {
+            auto prefix = std::format("posix/char/{}/", count);
+            std::vector<std::string> storage;
+            for(std::size_t i = 0; i < count; i++) {
+                storage.push_back("--option-" + bench::random_string<char>(8 + i % 24, i));
+            }
+            auto arguments = std::make_shared<const std::vector<std::string>>(std::move(storage));
+            auto views = std::make_shared<const std::vector<std::zstring_view>>(arguments->begin(), arguments->end());
+            bench::add(prefix + "vector<string> + vector<char*>", 0, [arguments](std::size_t iterations) {
+                for(std::size_t i = 0; i < iterations; i++) {
+                    std::vector<std::string> strings(arguments->begin(), arguments->end());
+                    std::vector<char*> argv;
+                    argv.reserve(strings.size() + 1);
+                    for(auto& str : strings) {
+                        argv.push_back(str.data());
+                    }
+                    argv.push_back(nullptr);
+                    bench::do_not_optimize(argv.data());
+                }
+            });
+            bench::add(prefix + "zstring_view_array", 0, [views](std::size_t iterations) {
+                for(std::size_t i = 0; i < iterations; i++) {
+                    zstring_posix::zstring_view_array argv(*views);
+                    bench::do_not_optimize(argv.data());
+                }
+            });
+        }
+    }
+
+    const bool registered = (register_posix(), true);
+}
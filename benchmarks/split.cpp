@@ -0,0 +1,65 @@
+#include "bench.hpp"
+
+#include <zstring_split.hpp>
+
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Tokenizing a delimited record into null-terminated fields: a std::string copy per token versus views::zsplit over a
+// mutable buffer. zsplit overwrites the delimiters, so its iterations include restoring the buffer with a memcpy.
+
+namespace {
+    constexpr std::size_t field_counts[] = {4, 16, 64};
+
+    std::string make_record(std::size_t fields) {
+        std::string record;
+        for(std::size_t i = 0; i < fields; i++) {
+            if(i) {
+                record += ',';
+            }
+            record += bench::random_string<char>(4 + i * 7 % 29, i);
+        }
+        return record;
+    }
+
+    void register_split() {
+        for(auto fields : field_counts) {
+            auto prefix = std::format("split/char/{}/", fields);
+            auto record = std::make_shared<const std::string>(make_record(fields));
+            bench::add(prefix + "std::string per token", record->size(), [record](std::size_t iterations) {
+                std::vector<std::string> tokens;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    tokens.clear();
+                    std::string_view rest = *record;
+                    bench::launder(rest);
+                    while(true) {
+                        auto pos = rest.find(',');
+                        tokens.emplace_back(rest.substr(0, pos));
+                        if(pos == std::string_view::npos) {
+                            break;
+                        }
+                        rest.remove_prefix(pos + 1);
+                    }
+                    bench::do_not_optimize(tokens.back().c_str());
+                }
+            });
+            bench::add(prefix + "views::zsplit", record->size(), [record](std::size_t iterations) {
+                std::string buffer = *record;
+                std::vector<std::zstring_view> tokens;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    tokens.clear();
+                    buffer.replace(0, buffer.size(), *record);
+                    for(auto token : std::views::zsplit(buffer, ',')) {
+                        tokens.push_back(token);
+                    }
+                    bench::do_not_optimize(tokens.back().c_str());
+                }
+            });
+        }
+    }
+
+    const bool registered = (register_split(), true);
+}
@@ -0,0 +1,134 @@
+#include "bench.hpp"
+
+#include <zstring_table.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Loading a table of 200k symbol names at startup: reading a text file with std::getline into a vector<std::string>
+// and indexing it with an unordered_map, versus opening a zstring_table, which maps the file and checks its header.
+// Then looking names up by id and by string in both. All loads include opening the file.
+
+namespace {
+    constexpr std::size_t symbol_count = 200'000;
+
+    // Names like ns_abcdef::abcdefghij::resize
+    std::vector<std::string> make_symbols() {
+        const char* members[] = {"::resize", "::size", "::data", "::operator[]", "::begin", "::end", "::find"};
+        std::vector<std::string> symbols;
+        symbols.reserve(symbol_count);
+        for(std::size_t i = 0; i < symbol_count; i++) {
+            symbols.push_back(
+                "ns_" + bench::random_string<char>(6, i % 500) + "::" + bench::random_string<char>(10, i / 7)
+                    + members[i % 7]
+            );
+        }
+        return symbols;
+    }
+
+    // The symbols as lines and as a string table in the temporary directory, removed when the last benchmark using
+    // them is destroyed
+    struct temporary_files {
+        std::filesystem::path text = std::filesystem::temp_directory_path() / "zstring_view_bench_symbols.txt";
+        std::filesystem::path table = std::filesystem::temp_directory_path() / "zstring_view_bench_symbols.zst";
+        std::vector<std::string> symbols = make_symbols();
+
+        temporary_files() {
+            std::ofstream file(text, std::ios::binary);
+            std::zstring_table_builder builder;
+            for(const auto& symbol : symbols) {
+                file << symbol << '\n';
+                builder.add(symbol);
+            }
+            builder.write(table.c_str());
+        }
+        ~temporary_files() {
+            std::error_code ec;
+            std::filesystem::remove(text, ec);
+            std::filesystem::remove(table, ec);
+        }
+        temporary_files(const temporary_files&) = delete;
+        temporary_files& operator=(const temporary_files&) = delete;
+    };
+
+    struct loaded_strings {
+        std::vector<std::string> strings;
+        std::unordered_map<std::string_view, std::size_t> ids;
+    };
+
+    loaded_strings load_strings(const std::filesystem::path& path) {
+        loaded_strings loaded;
+        std::ifstream stream(path, std::ios::binary);
+        std::string line;
+        while(std::getline(stream, line)) {
+            loaded.strings.push_back(line);
+        }
+        loaded.ids.reserve(loaded.strings.size());
+        for(std::size_t id = 0; id < loaded.strings.size(); id++) {
+            loaded.ids.try_emplace(loaded.strings[id], id);
+        }
+        return loaded;
+    }
+
+    void register_table() {
+        auto files = std::make_shared<temporary_files>();
+        const std::string prefix = "table/char/" + std::to_string(symbol_count) + "/";
+
+        bench::add(prefix + "load: getline + unordered_map", 0, [files](std::size_t iterations) {
+            for(std::size_t i = 0; i < iterations; i++) {
+                auto loaded = load_strings(files->text);
+                bench::do_not_optimize(loaded.ids.size());
+            }
+        });
+        bench::add(prefix + "load: zstring_table", 0, [files](std::size_t iterations) {
+            for(std::size_t i = 0; i < iterations; i++) {
+                std::zstring_table table(files->table.c_str());
+                bench::do_not_optimize(table[i % symbol_count].c_str());
+            }
+        });
+        bench::add(prefix + "load: zstring_table + verify_checksum", 0, [files](std::size_t iterations) {
+            for(std::size_t i = 0; i < iterations; i++) {
+                std::zstring_table table(files->table.c_str());
+                bench::do_not_optimize(table.verify_checksum());
+            }
+        });
+
+        // Lookups of 1024 names spread over the table
+        auto strings = std::make_shared<const loaded_strings>(load_strings(files->text));
+        auto table = std::make_shared<const std::zstring_table>(files->table.c_str());
+        auto probes = std::make_shared<std::vector<std::string>>();
+        for(std::size_t i = 0; i < 1024; i++) {
+            probes->push_back(files->symbols[i * 7919 % symbol_count]);
+        }
+        bench::add(prefix + "find: unordered_map", 0, [strings, probes](std::size_t iterations) {
+            for(std::size_t i = 0; i < iterations; i++) {
+                const std::string_view probe = (*probes)[i % probes->size()];
+                bench::do_not_optimize(strings->ids.find(probe)->second);
+            }
+        });
+        bench::add(prefix + "find: zstring_table", 0, [table, probes](std::size_t iterations) {
+            for(std::size_t i = 0; i < iterations; i++) {
+                const std::string_view probe = (*probes)[i % probes->size()];
+                bench::do_not_optimize(table->find(probe));
+            }
+        });
+        bench::add(prefix + "by id: vector<string>", 0, [strings](std::size_t iterations) {
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::do_not_optimize(strings->strings[i * 7919 % symbol_count].c_str());
+            }
+        });
+        bench::add(prefix + "by id: zstring_table", 0, [table](std::size_t iterations) {
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::do_not_optimize((*table)[i * 7919 % symbol_count].c_str());
+            }
+        });
+    }
+
+    const bool registered = (register_table(), true);
+}
@@ -0,0 +1,108 @@
+#include "bench.hpp"
+
+#include <zstring_transcode.hpp>
+
+#include <format>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// transcode and transcoded_length versus a scalar reference that decodes and encodes one code point at a time with the
+// same validation, on all-ASCII text, mostly-ASCII text with some accented letters, and CJK text.
+
+namespace {
+    constexpr std::size_t lengths[] = {64, 4096};
+
+    // Code points drawn from the given mix
+    std::u32string random_text(std::size_t length, std::uint64_t seed, int percent_two_byte, int percent_three_byte) {
+        std::mt19937_64 rng(seed);
+        std::u32string text(length, U'\0');
+        for(auto& c : text) {
+            const int r = static_cast<int>(rng() % 100);
+            if(r < percent_three_byte) {
+                c = static_cast<char32_t>(0x4e00 + rng() % 0x5000);
+            } else if(r < percent_three_byte + percent_two_byte) {
+                c = static_cast<char32_t>(0xc0 + rng() % 0x40);
+            } else {
+                c = static_cast<char32_t>(' ' + rng() % 95);
+            }
+        }
+        return text;
+    }
+
+    template<typename charT>
+    std::basic_string<charT> encode(const std::u32string& text) {
+        std::basic_string<charT> str;
+        for(char32_t c : text) {
+            charT units[4];
+            std::__zsv::__encode(c, units);
+            str.append(units, std::__zsv::__encoded_length<charT>(c));
+        }
+        return str;
+    }
+
+    template<typename To, typename From>
+    std::size_t reference_transcode(std::basic_zstring_view<From> src, To* dst) {
+        std::size_t i = 0;
+        std::size_t o = 0;
+        while(i < src.size()) {
+            const char32_t c = std::__zsv::__decode(src.data(), src.size(), i);
+            if(c == std::__zsv::__invalid_code_point) {
+                break;
+            }
+            std::__zsv::__encode(c, dst + o);
+            o += std::__zsv::__encoded_length<To>(c);
+        }
+        dst[o] = To();
+        return o;
+    }
+
+    template<typename To, typename From>
+    void add_direction(const std::string& prefix, std::shared_ptr<const std::basic_string<From>> src) {
+        const std::size_t bytes = src->size() * sizeof(From);
+        auto buffer = std::make_shared<std::vector<To>>(src->size() * 4 + 1);
+        bench::add(prefix + "scalar reference", bytes, [src, buffer](std::size_t iterations) {
+            std::basic_zstring_view<From> view = *src;
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(view);
+                bench::do_not_optimize(reference_transcode(view, buffer->data()));
+            }
+        });
+        bench::add(prefix + "transcode", bytes, [src, buffer](std::size_t iterations) {
+            std::basic_zstring_view<From> view = *src;
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(view);
+                bench::do_not_optimize(std::transcode<To>(view, std::span<To>(*buffer)).str.size());
+            }
+        });
+        bench::add(prefix + "transcoded_length", bytes, [src](std::size_t iterations) {
+            std::basic_zstring_view<From> view = *src;
+            for(std::size_t i = 0; i < iterations; i++) {
+                bench::launder(view);
+                bench::do_not_optimize(std::transcoded_length<To>(view).size);
+            }
+        });
+    }
+
+    void register_transcode() {
+        struct mix {
+            const char* name;
+            int percent_two_byte;
+            int percent_three_byte;
+        };
+        constexpr mix mixes[] = {{"ascii", 0, 0}, {"latin", 5, 0}, {"cjk", 0, 100}};
+        for(auto length : lengths) {
+            for(auto [name, two_byte, three_byte] : mixes) {
+                const std::u32string text = random_text(length, length, two_byte, three_byte);
+                auto utf8 = std::make_shared<const std::u8string>(encode<char8_t>(text));
+                auto utf16 = std::make_shared<const std::u16string>(encode<char16_t>(text));
+                add_direction<char16_t>(std::format("transcode/{}/{}/utf8->utf16/", name, length), utf8);
+                add_direction<char32_t>(std::format("transcode/{}/{}/utf8->utf32/", name, length), utf8);
+                add_direction<char8_t>(std::format("transcode/{}/{}/utf16->utf8/", name, length), utf16);
+            }
+        }
+    }
+
+    const bool registered = (register_transcode(), true);
+}
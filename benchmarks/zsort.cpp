@@ -0,0 +1,98 @@
+#include "bench.hpp"
+
+#include <zsort.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+#include <format>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Sorting arrays of zstring_view: std::sort (full comparisons from the first character) versus zsort, sequential and
+// with std::execution::par, on file paths that share long prefixes and on random keys. Each iteration sorts a fresh copy
+// of the unsorted array. The unique variants also drop duplicates, with std::unique and with zunique on zsort's LCPs.
+
+namespace {
+    constexpr std::size_t counts[] = {10'000, 100'000, 1'000'000};
+
+    // Paths like /usr/lib/x86_64-linux-gnu/package/module/file.so; about one in eight is a duplicate
+    std::vector<std::string> make_paths(std::size_t count) {
+        const char* roots[] = {"/usr/lib/x86_64-linux-gnu/", "/usr/share/doc/", "/home/user/projects/", "/var/log/"};
+        std::mt19937_64 rng(count);
+        std::vector<std::string> paths;
+        paths.reserve(count);
+        for(std::size_t i = 0; i < count; i++) {
+            if(i % 8 == 7) {
+                paths.push_back(paths[rng() % paths.size()]);
+                continue;
+            }
+            paths.push_back(std::format(
+                "{}{}/{}/{}.so",
+                roots[rng() % 4],
+                bench::random_string<char>(6, rng() % 200),
+                bench::random_string<char>(8, rng() % 2000),
+                bench::random_string<char>(10, rng())
+            ));
+        }
+        return paths;
+    }
+
+    std::vector<std::string> make_keys(std::size_t count) {
+        std::mt19937_64 rng(count + 1);
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        for(std::size_t i = 0; i < count; i++) {
+            keys.push_back(bench::random_string<char>(8 + rng() % 24, rng(), '0', 'z'));
+        }
+        return keys;
+    }
+
+    void add_sorts(const std::string& prefix, std::vector<std::string> storage) {
+        auto strings = std::make_shared<const std::vector<std::string>>(std::move(storage));
+        auto views = std::make_shared<const std::vector<std::zstring_view>>(strings->begin(), strings->end());
+        std::size_t bytes = 0;
+        for(const auto& str : *strings) {
+            bytes += str.size();
+        }
+        auto add = [&](const std::string& name, auto sort) {
+            bench::add(prefix + name, bytes, [strings, views, sort](std::size_t iterations) {
+                std::vector<std::zstring_view> work;
+                for(std::size_t i = 0; i < iterations; i++) {
+                    work = *views;
+                    sort(work);
+                    bench::do_not_optimize(work.data());
+                }
+            });
+        };
+        add("std::sort", [](std::vector<std::zstring_view>& work) {
+            std::sort(work.begin(), work.end());
+        });
+        add("zsort", [](std::vector<std::zstring_view>& work) {
+            std::zsort(work);
+        });
+        add("zsort(par)", [](std::vector<std::zstring_view>& work) {
+            std::zsort(std::execution::par, work);
+        });
+        add("std::sort + std::unique", [](std::vector<std::zstring_view>& work) {
+            std::sort(work.begin(), work.end());
+            work.erase(std::unique(work.begin(), work.end()), work.end());
+        });
+        add("zsort + zunique(lcp)", [](std::vector<std::zstring_view>& work) {
+            std::vector<std::size_t> lcp(work.size());
+            std::zsort(work, lcp);
+            work.resize(std::zunique(work, lcp));
+        });
+    }
+
+    void register_zsort() {
+        for(auto count : counts) {
+            add_sorts(std::format("zsort/char/{}/paths/", count), make_paths(count));
+            add_sorts(std::format("zsort/char/{}/keys/", count), make_keys(count));
+        }
+    }
+
+    const bool registered = (register_zsort(), true);
+}
@@ -0,0 +1,210 @@
+#ifndef CI_CHAR_TRAITS_HPP
+#define CI_CHAR_TRAITS_HPP
+
+#include "zstring_view.hpp"
+#include "zstring_hash.hpp"
+
+#include <bit>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// NOTE: Not part of proposal. ci_char_traits compares char strings ignoring ASCII case, for protocol tokens such as
+// HTTP header names and hostnames:
+//
+//     std::ci_zstring_view name = header.name;
+//     if(name == "Content-Length") { ... }
+//
+// Only 'A'-'Z' and 'a'-'z' are folded; other bytes, including UTF-8 sequences, compare as themselves, ordered as
+// unsigned char like char_traits<char>. compare and find work on whole vectors at a time, and std::hash hashes the
+// folded bytes with wyhash, so strings that compare equal hash equal.
+
+namespace std {
+    struct ci_char_traits;
+
+    // ci_char_traits typedef-names
+    using ci_string_view  = basic_string_view<char, ci_char_traits>;
+    using ci_zstring_view = basic_zstring_view<char, ci_char_traits>;
+
+    // hash support
+    template<> struct hash<ci_string_view>;
+    template<> struct hash<ci_zstring_view>;
+}
+
+namespace std::__zsv {
+    constexpr char __ci_fold(char c) noexcept {
+        return c >= 'A' && c <= 'Z' ? char(c + ('a' - 'A')) : c;
+    }
+
+    // Folds the eight bytes of word at once: a byte is upper case if its low seven bits are at least 'A' and at most
+    // 'Z' and its top bit is clear. The additions can't carry between bytes since the top bits are masked off first.
+    constexpr uint64_t __ci_fold_word(uint64_t word) noexcept {
+        constexpr uint64_t ones = 0x0101010101010101;
+        const uint64_t low_bits = word & (ones * 0x7f);
+        const uint64_t at_least_a = low_bits + ones * (0x80 - 'A');
+        const uint64_t above_z = low_bits + ones * (0x80 - 'Z' - 1);
+        const uint64_t upper = at_least_a & ~above_z & ~word & (ones * 0x80);
+        return word | (upper >> 2);
+    }
+
+    // A __byte_reader for __wyhash that folds case as it reads
+    struct __ci_byte_reader {
+        const char* str;
+
+        constexpr uint64_t byte(size_t offset) const noexcept {
+            return static_cast<unsigned char>(__ci_fold(str[offset]));
+        }
+        template<size_t N>
+        constexpr uint64_t read(size_t offset) const noexcept {
+            return __ci_fold_word(__byte_reader<char>{str}.template read<N>(offset));
+        }
+    };
+
+    #ifdef ZSTRING_VIEW_X86_SIMD
+    ZSTRING_VIEW_ALWAYS_INLINE __m128i __ci_fold_sse2(__m128i v) noexcept {
+        // Bytes from 0x80 up are negative as signed char and so never in range
+        const __m128i upper = _mm_and_si128(
+            _mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+            _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1))
+        );
+        return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+    }
+
+    ZSTRING_VIEW_ALWAYS_INLINE ZSTRING_VIEW_TARGET_AVX2 __m256i __ci_fold_avx2(__m256i v) noexcept {
+        const __m256i upper = _mm256_and_si256(
+            _mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v)
+        );
+        return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+    }
+
+    // Index of the first of the n bytes at which x and y differ after folding, or n. Reads stay within the n bytes.
+    inline size_t __ci_mismatch_sse2(const char* x, const char* y, size_t n) noexcept {
+        size_t i = 0;
+        for(; n - i >= 16; i += 16) {
+            const __m128i a = __ci_fold_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)));
+            const __m128i b = __ci_fold_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)));
+            const uint32_t equal = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+            if(equal != 0xffff) {
+                return i + countr_zero(~equal);
+            }
+        }
+        for(; i < n && __ci_fold(x[i]) == __ci_fold(y[i]); i++) {}
+        return i;
+    }
+
+    ZSTRING_VIEW_TARGET_AVX2 inline size_t __ci_mismatch_avx2(const char* x, const char* y, size_t n) noexcept {
+        size_t i = 0;
+        // Two vectors per iteration, with one test for both
+        for(; n - i >= 64; i += 64) {
+            const __m256i a0 = __ci_fold_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)));
+            const __m256i b0 = __ci_fold_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)));
+            const __m256i a1 = __ci_fold_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i + 32)));
+            const __m256i b1 = __ci_fold_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i + 32)));
+            const __m256i differences = _mm256_or_si256(_mm256_xor_si256(a0, b0), _mm256_xor_si256(a1, b1));
+            if(!_mm256_testz_si256(differences, differences)) {
+                break;
+            }
+        }
+        for(; n - i >= 32; i += 32) {
+            const __m256i a = __ci_fold_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)));
+            const __m256i b = __ci_fold_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)));
+            const uint32_t equal = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+            if(equal != 0xffffffff) {
+                return i + countr_zero(~equal);
+            }
+        }
+        return i + __ci_mismatch_sse2(x + i, y + i, n - i);
+    }
+
+    // Index of the first of the n bytes at str equal to c, which is already folded, after folding, or n
+    inline size_t __ci_find_sse2(const char* str, size_t n, char c) noexcept {
+        const __m128i needle = _mm_set1_epi8(c);
+        size_t i = 0;
+        for(; n - i >= 16; i += 16) {
+            const __m128i v = __ci_fold_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i)));
+            if(const uint32_t hits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)))) {
+                return i + countr_zero(hits);
+            }
+        }
+        for(; i < n && __ci_fold(str[i]) != c; i++) {}
+        return i;
+    }
+
+    ZSTRING_VIEW_TARGET_AVX2 inline size_t __ci_find_avx2(const char* str, size_t n, char c) noexcept {
+        const __m256i needle = _mm256_set1_epi8(c);
+        size_t i = 0;
+        for(; n - i >= 32; i += 32) {
+            const __m256i v = __ci_fold_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i)));
+            if(const uint32_t hits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)))) {
+                return i + countr_zero(hits);
+            }
+        }
+        return i + __ci_find_sse2(str + i, n - i, c);
+    }
+    #endif
+
+    constexpr size_t __ci_mismatch(const char* x, const char* y, size_t n) noexcept {
+        #ifdef ZSTRING_VIEW_X86_SIMD
+        if(!is_constant_evaluated()) {
+            return __has_avx2 ? __ci_mismatch_avx2(x, y, n) : __ci_mismatch_sse2(x, y, n);
+        }
+        #endif
+        size_t i = 0;
+        for(; i < n && __ci_fold(x[i]) == __ci_fold(y[i]); i++) {}
+        return i;
+    }
+
+    constexpr size_t __ci_find(const char* str, size_t n, char c) noexcept {
+        c = __ci_fold(c);
+        #ifdef ZSTRING_VIEW_X86_SIMD
+        if(!is_constant_evaluated()) {
+            return __has_avx2 ? __ci_find_avx2(str, n, c) : __ci_find_sse2(str, n, c);
+        }
+        #endif
+        size_t i = 0;
+        for(; i < n && __ci_fold(str[i]) != c; i++) {}
+        return i;
+    }
+}
+
+namespace std {
+    struct ci_char_traits : char_traits<char> {
+        // Strings that differ only in case are equivalent but not equal
+        using comparison_category = weak_ordering;
+
+        static constexpr bool eq(char_type c, char_type d) noexcept {
+            return __zsv::__ci_fold(c) == __zsv::__ci_fold(d);
+        }
+        static constexpr bool lt(char_type c, char_type d) noexcept {
+            return static_cast<unsigned char>(__zsv::__ci_fold(c)) < static_cast<unsigned char>(__zsv::__ci_fold(d));
+        }
+        static constexpr int compare(const char_type* s1, const char_type* s2, size_t n) noexcept {
+            const size_t i = __zsv::__ci_mismatch(s1, s2, n);
+            if(i == n) {
+                return 0;
+            }
+            return lt(s1[i], s2[i]) ? -1 : 1;
+        }
+        // Folding never turns a byte into the terminator, so the length is char_traits<char>::length's (strlen)
+        static constexpr const char_type* find(const char_type* s, size_t n, const char_type& a) noexcept {
+            const size_t i = __zsv::__ci_find(s, n, a);
+            return i == n ? nullptr : s + i;
+        }
+    };
+
+    // Hashes the case-folded bytes, so equal strings hash equal
+    template<> struct hash<ci_string_view> {
+        constexpr size_t operator()(ci_string_view sv) const noexcept {
+            return static_cast<size_t>(__zsv::__wyhash(__zsv::__ci_byte_reader{sv.data()}, sv.size(), 0));
+        }
+    };
+    template<> struct hash<ci_zstring_view> {
+        constexpr size_t operator()(ci_zstring_view sv) const noexcept {
+            return std::hash<ci_string_view>{}(sv);
+        }
+    };
+}
+
+#endif
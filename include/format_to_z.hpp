@@ -0,0 +1,149 @@
+#ifndef FORMAT_TO_Z_HPP
+#define FORMAT_TO_Z_HPP
+
+#include "zstring_view.hpp"
+#include "zstring_arena.hpp"
+
+#include <cassert>
+#include <format>
+#include <memory>
+#include <span>
+
+// NOTE: Not part of proposal. format_to_z formats into storage the caller provides, always appends the terminator,
+// and returns the result as a basic_zstring_view, so formatted output can go straight to a C API without a
+// std::string:
+//
+//     char buffer[PATH_MAX];
+//     auto path = std::format_to_z(buffer, "{}/{}.log", directory, name);
+//     if(!path.truncated) {
+//         ::open(path.str.c_str(), O_RDONLY);
+//     }
+//
+// The storage can be a fixed span, which truncates, a basic_zformat_buffer, which starts out inline and grows onto
+// the heap, or a basic_zstring_arena.
+
+namespace std {
+    template<class charT>
+    struct format_to_z_result {
+        basic_zstring_view<charT> str; // the output, possibly truncated
+        size_t size;                   // the size of the complete output
+        bool truncated;
+    };
+
+    template<class charT, size_t N = 256>
+    class basic_zformat_buffer;
+
+    // basic_zformat_buffer typedef-names
+    using zformat_buffer  = basic_zformat_buffer<char>;
+    using wzformat_buffer = basic_zformat_buffer<wchar_t>;
+}
+
+namespace std::__zsv {
+    // Formats into buffer, which must have room for at least the terminator. Output that doesn't fit is formatted a
+    // second time, so the arguments are only ever passed on as lvalues and format strings are typed accordingly.
+    template<class charT, class... Args>
+    format_to_z_result<charT> __format_to_z(
+        span<charT> buffer,
+        basic_format_string<charT, type_identity_t<Args>&...> fmt,
+        Args&... args
+    ) {
+        assert(!buffer.empty());
+        const size_t capacity = buffer.size() - 1;
+        const auto result = std::format_to_n(buffer.data(), capacity, fmt, args...);
+        const size_t size = static_cast<size_t>(result.size);
+        const size_t written = size < capacity ? size : capacity;
+        buffer[written] = charT();
+        return {basic_zstring_view<charT>(buffer.data(), written), size, size > capacity};
+    }
+}
+
+namespace std {
+    // Holds the output of one format_to_z call, inline if it fits in N code units including the terminator and on the
+    // heap otherwise. The result points into the buffer, so it can be neither copied nor moved.
+    template<class charT, size_t N>
+    class basic_zformat_buffer {
+        static_assert(N > 0, "the inline storage needs room for the terminator");
+
+    public:
+        static constexpr size_t inline_capacity = N;
+
+        basic_zformat_buffer() noexcept = default;
+        basic_zformat_buffer(const basic_zformat_buffer&) = delete;
+        basic_zformat_buffer& operator=(const basic_zformat_buffer&) = delete;
+
+        // Replaces the contents; output that doesn't fit inline is formatted a second time into heap storage
+        template<class... Args>
+        basic_zstring_view<charT> format(basic_format_string<charT, type_identity_t<Args>&...> fmt, Args&&... args) {
+            auto result = __zsv::__format_to_z(span<charT>(storage_), fmt, args...);
+            if(!result.truncated) {
+                view_ = result.str;
+            } else {
+                if(result.size + 1 > heap_size_) {
+                    heap_ = make_unique_for_overwrite<charT[]>(result.size + 1);
+                    heap_size_ = result.size + 1;
+                }
+                view_ = __zsv::__format_to_z(span<charT>(heap_.get(), heap_size_), fmt, args...).str;
+            }
+            return view_;
+        }
+
+        basic_zstring_view<charT> view() const noexcept {
+            return view_;
+        }
+        operator basic_zstring_view<charT>() const noexcept {
+            return view_;
+        }
+        const charT* c_str() const noexcept {
+            return view_.c_str();
+        }
+
+    private:
+        basic_zstring_view<charT> view_;
+        unique_ptr<charT[]> heap_;
+        size_t heap_size_ = 0;
+        charT storage_[N];
+    };
+
+    // Formats into buffer, truncating output that doesn't fit along with the terminator. buffer must not be empty.
+    template<class... Args>
+    format_to_z_result<char> format_to_z(span<char> buffer, format_string<Args&...> fmt, Args&&... args) {
+        return __zsv::__format_to_z(buffer, fmt, args...);
+    }
+    template<class... Args>
+    format_to_z_result<wchar_t> format_to_z(span<wchar_t> buffer, wformat_string<Args&...> fmt, Args&&... args) {
+        return __zsv::__format_to_z(buffer, fmt, args...);
+    }
+
+    // Formats into buffer, replacing its contents
+    template<size_t N, class... Args>
+    zstring_view format_to_z(basic_zformat_buffer<char, N>& buffer, format_string<Args&...> fmt, Args&&... args) {
+        return buffer.format(fmt, args...);
+    }
+    template<size_t N, class... Args>
+    wzstring_view format_to_z(basic_zformat_buffer<wchar_t, N>& buffer, wformat_string<Args&...> fmt, Args&&... args) {
+        return buffer.format(fmt, args...);
+    }
+
+    // Formats into arena storage, as if by arena.store(std::format(fmt, args...))
+    template<class charT, class Allocator, class... Args>
+    basic_zstring_view<charT> format_to_z(
+        basic_zstring_arena<charT, char_traits<charT>, Allocator>& arena,
+        basic_format_string<type_identity_t<charT>, type_identity_t<Args>&...> fmt,
+        Args&&... args
+    ) {
+        // Short output is formatted on the stack and copied, longer output is formatted a second time in place
+        charT stack[256];
+        const auto result = __zsv::__format_to_z(span<charT>(stack), fmt, args...);
+        if(!result.truncated) {
+            return arena.store(result.str);
+        }
+        if(arena.deduplicating()) {
+            // The output may already be stored, so it can't be formatted into arena storage first
+            return arena.store(std::format(fmt, args...));
+        }
+        charT* data = arena.allocate(result.size + 1);
+        return __zsv::__format_to_z(span<charT>(data, result.size + 1), fmt, args...).str;
+    }
+}
+
+#endif
@@ -0,0 +1,277 @@
+#ifndef HASHED_ZSTRING_VIEW_HPP
+#define HASHED_ZSTRING_VIEW_HPP
+
+#include "zstring_view.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+// NOTE: Not part of proposal. basic_hashed_zstring_view is a basic_zstring_view that computes its hash once, when it
+// is constructed, for keys that are looked up many times. Equality rejects on a hash mismatch before comparing
+// characters, so the hash must agree with traits: with other traits than char_traits, where strings with different
+// code units can be equal, it is the one hash<basic_string_view<charT, traits>> computes, which must be enabled.
+
+namespace std {
+    template<class charT, class traits = char_traits<charT>>
+    class basic_hashed_zstring_view;
+
+    namespace ranges {
+        template<class charT, class traits>
+            constexpr bool enable_view<basic_hashed_zstring_view<charT, traits>> = true;
+        template<class charT, class traits>
+            constexpr bool enable_borrowed_range<basic_hashed_zstring_view<charT, traits>> = true;
+    }
+
+    // basic_hashed_zstring_view typedef-names
+    using hashed_zstring_view    = basic_hashed_zstring_view<char>;
+    using u8hashed_zstring_view  = basic_hashed_zstring_view<char8_t>;
+    using u16hashed_zstring_view = basic_hashed_zstring_view<char16_t>;
+    using u32hashed_zstring_view = basic_hashed_zstring_view<char32_t>;
+    using whashed_zstring_view   = basic_hashed_zstring_view<wchar_t>;
+
+    // hash support
+    template<class charT, class traits> struct hash<basic_hashed_zstring_view<charT, traits>>;
+
+    inline namespace literals {
+        inline namespace zstring_view_literals {
+            #ifndef _MSC_VER
+            #pragma GCC diagnostic push
+            #ifdef __clang__
+            #pragma GCC diagnostic ignored "-Wuser-defined-literals"
+            #else
+            #pragma GCC diagnostic ignored "-Wliteral-suffix"
+            #endif
+            #else
+            #pragma warning(push)
+            #pragma warning(disable: 4455)
+            #endif
+            // suffix for basic_hashed_zstring_view literals, the hash is always computed at compile time
+            consteval hashed_zstring_view    operator"" hzsv(const char* str, size_t len) noexcept;
+            consteval u8hashed_zstring_view  operator"" hzsv(const char8_t* str, size_t len) noexcept;
+            consteval u16hashed_zstring_view operator"" hzsv(const char16_t* str, size_t len) noexcept;
+            consteval u32hashed_zstring_view operator"" hzsv(const char32_t* str, size_t len) noexcept;
+            consteval whashed_zstring_view   operator"" hzsv(const wchar_t* str, size_t len) noexcept;
+            #ifndef _MSC_VER
+            #pragma GCC diagnostic pop
+            #else
+            #pragma warning(pop)
+            #endif
+        }
+    }
+}
+
+namespace std::__zsv {
+    // 64-bit FNV-1a over the bytes of each code unit, least significant byte first, which gives the same result during
+    // constant evaluation and at run time
+    template<class charT>
+    constexpr size_t __fnv1a(const charT* str, size_t size) noexcept {
+        uint64_t hash = 0xcbf29ce484222325;
+        for(size_t i = 0; i < size; i++) {
+            const uint32_t unit = __unit(str[i]);
+            for(size_t byte = 0; byte < sizeof(charT); byte++) {
+                hash ^= (unit >> (8 * byte)) & 0xff;
+                hash *= 0x100000001b3;
+            }
+        }
+        return static_cast<size_t>(hash);
+    }
+
+    template<class charT, class traits>
+    constexpr size_t __hashed_view_hash(basic_string_view<charT, traits> str) noexcept {
+        if constexpr(__is_default_traits<charT, traits>) {
+            return __fnv1a(str.data(), str.size());
+        } else {
+            return hash<basic_string_view<charT, traits>>{}(str);
+        }
+    }
+}
+
+namespace std {
+    template<class charT, class traits /* = char_traits<charT> */>
+    class basic_hashed_zstring_view {
+        static_assert(
+            __zsv::__is_default_traits<charT, traits> || is_default_constructible_v<std::hash<basic_string_view<charT, traits>>>,
+            "basic_hashed_zstring_view needs a hash consistent with traits"
+        );
+
+    public:
+        // types
+        using zstring_view_type      = basic_zstring_view<charT, traits>;
+        using traits_type            = traits;
+        using value_type             = charT;
+        using pointer                = value_type*;
+        using const_pointer          = const value_type*;
+        using reference              = value_type&;
+        using const_reference        = const value_type&;
+        using const_iterator         = typename zstring_view_type::const_iterator;
+        using iterator               = const_iterator;
+        using const_reverse_iterator = typename zstring_view_type::const_reverse_iterator;
+        using reverse_iterator       = const_reverse_iterator;
+        using size_type              = size_t;
+        using difference_type        = ptrdiff_t;
+        static constexpr size_type npos = zstring_view_type::npos;
+
+        // construction and assignment
+        constexpr basic_hashed_zstring_view() noexcept : basic_hashed_zstring_view(zstring_view_type()) {}
+        constexpr basic_hashed_zstring_view(const basic_hashed_zstring_view&) noexcept = default;
+        constexpr basic_hashed_zstring_view& operator=(const basic_hashed_zstring_view&) noexcept = default;
+        constexpr basic_hashed_zstring_view(zstring_view_type str) noexcept
+            : str_(str), hash_(__zsv::__hashed_view_hash<charT, traits>(str)) {}
+        constexpr basic_hashed_zstring_view(const charT* str) : basic_hashed_zstring_view(zstring_view_type(str)) {}
+        constexpr basic_hashed_zstring_view(const charT* str, size_type len)
+            : basic_hashed_zstring_view(zstring_view_type(str, len)) {}
+        basic_hashed_zstring_view(nullptr_t) = delete;
+        template<typename Traits, typename Allocator>
+        constexpr basic_hashed_zstring_view(const std::basic_string<charT, Traits, Allocator>& str)
+            : basic_hashed_zstring_view(zstring_view_type(str)) {}
+
+        // iterator support
+        constexpr const_iterator begin() const noexcept {
+            return str_.begin();
+        }
+        constexpr const_iterator end() const noexcept {
+            return str_.end();
+        }
+        constexpr const_iterator cbegin() const noexcept {
+            return begin();
+        }
+        constexpr const_iterator cend() const noexcept {
+            return end();
+        }
+        constexpr const_reverse_iterator rbegin() const noexcept {
+            return str_.rbegin();
+        }
+        constexpr const_reverse_iterator rend() const noexcept {
+            return str_.rend();
+        }
+        constexpr const_reverse_iterator crbegin() const noexcept {
+            return rbegin();
+        }
+        constexpr const_reverse_iterator crend() const noexcept {
+            return rend();
+        }
+
+        // capacity
+        constexpr size_type size() const noexcept {
+            return str_.size();
+        }
+        constexpr size_type length() const noexcept {
+            return str_.length();
+        }
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return str_.empty();
+        }
+
+        // element access
+        constexpr const_reference operator[](size_type pos) const {
+            return str_[pos];
+        }
+        constexpr const_pointer data() const noexcept {
+            return str_.data();
+        }
+        constexpr const_pointer c_str() const noexcept {
+            return str_.c_str();
+        }
+
+        // the cached hash
+        constexpr size_t hash() const noexcept {
+            return hash_;
+        }
+
+        constexpr zstring_view_type view() const noexcept {
+            return str_;
+        }
+        constexpr operator zstring_view_type() const noexcept {
+            return str_;
+        }
+        constexpr operator basic_string_view<charT, traits>() const noexcept {
+            return str_;
+        }
+
+        constexpr void swap(basic_hashed_zstring_view& s) noexcept {
+            str_.swap(s.str_);
+            std::swap(hash_, s.hash_);
+        }
+
+        // comparison, strings without a cached hash are compared character by character
+        friend constexpr bool operator==(const basic_hashed_zstring_view& x, const basic_hashed_zstring_view& y) noexcept {
+            return x.hash_ == y.hash_ && x.str_ == y.str_;
+        }
+        friend constexpr auto operator<=>(const basic_hashed_zstring_view& x, const basic_hashed_zstring_view& y) noexcept {
+            return x.str_ <=> y.str_;
+        }
+        template<class T>
+            requires (!is_same_v<T, basic_hashed_zstring_view>)
+                && is_convertible_v<const T&, basic_string_view<charT, traits>>
+        friend constexpr bool operator==(const basic_hashed_zstring_view& x, const T& y) noexcept {
+            return basic_string_view<charT, traits>(x) == basic_string_view<charT, traits>(y);
+        }
+        template<class T>
+            requires (!is_same_v<T, basic_hashed_zstring_view>)
+                && is_convertible_v<const T&, basic_string_view<charT, traits>>
+        friend constexpr auto operator<=>(const basic_hashed_zstring_view& x, const T& y) noexcept {
+            return basic_string_view<charT, traits>(x) <=> basic_string_view<charT, traits>(y);
+        }
+
+    private:
+        zstring_view_type str_;
+        size_t hash_;
+    };
+
+    template<class charT, class traits>
+    basic_ostream<charT, traits>& operator<<(basic_ostream<charT, traits>& os, basic_hashed_zstring_view<charT, traits> str) {
+        return os<<str.view();
+    }
+
+    // Returns the cached hash. Transparent, so containers keyed by basic_hashed_zstring_view can be probed with any
+    // string convertible to basic_string_view (with std::equal_to<> as the key equality), hashing it on the fly.
+    template<class charT, class traits>
+    struct hash<basic_hashed_zstring_view<charT, traits>> {
+        using is_transparent = void;
+
+        constexpr size_t operator()(const basic_hashed_zstring_view<charT, traits>& str) const noexcept {
+            return str.hash();
+        }
+        template<class T>
+            requires (!is_same_v<T, basic_hashed_zstring_view<charT, traits>>)
+                && is_convertible_v<const T&, basic_string_view<charT, traits>>
+        constexpr size_t operator()(const T& str) const noexcept {
+            return __zsv::__hashed_view_hash<charT, traits>(str);
+        }
+    };
+
+    inline namespace literals {
+        inline namespace zstring_view_literals {
+            #pragma GCC diagnostic push
+            #pragma GCC diagnostic ignored "-Wliteral-suffix"
+            consteval hashed_zstring_view    operator""hzsv(const char* str, size_t len) noexcept {
+                return basic_hashed_zstring_view(str, len);
+            }
+            consteval u8hashed_zstring_view  operator""hzsv(const char8_t* str, size_t len) noexcept {
+                return basic_hashed_zstring_view(str, len);
+            }
+            consteval u16hashed_zstring_view operator""hzsv(const char16_t* str, size_t len) noexcept {
+                return basic_hashed_zstring_view(str, len);
+            }
+            consteval u32hashed_zstring_view operator""hzsv(const char32_t* str, size_t len) noexcept {
+                return basic_hashed_zstring_view(str, len);
+            }
+            consteval whashed_zstring_view   operator""hzsv(const wchar_t* str, size_t len) noexcept {
+                return basic_hashed_zstring_view(str, len);
+            }
+            #pragma GCC diagnostic pop
+        }
+    }
+
+    // [format.formatter.spec]
+    template<class charT, class traits>
+    struct formatter<basic_hashed_zstring_view<charT, traits>, charT> : formatter<basic_zstring_view<charT, traits>, charT> {
+        template<typename _Out>
+        auto format(basic_hashed_zstring_view<charT, traits> str, basic_format_context<_Out, charT>& context) const {
+            return formatter<basic_zstring_view<charT, traits>, charT>::format(str.view(), context);
+        }
+    };
+}
+
+#endif
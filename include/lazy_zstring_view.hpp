@@ -0,0 +1,318 @@
+#ifndef LAZY_ZSTRING_VIEW_HPP
+#define LAZY_ZSTRING_VIEW_HPP
+
+#include "zstring_view.hpp"
+
+#include <compare>
+#include <concepts>
+#include <cstring>
+#include <cwchar>
+#include <type_traits>
+
+// NOTE: Not part of proposal. basic_lazy_zstring_view is a basic_zstring_view that doesn't scan for the terminator
+// until the length is needed, for strings received as a bare pointer (e.g. from a C callback) that are often only
+// forwarded, checked for a prefix, or compared. The length is computed on the first call to size(), end() or a
+// conversion and cached. starts_with, compare and the comparison operators only scan as far as the other operand
+// needs, and find(charT) stops at the first match or the terminator, instead of computing the length first.
+//
+// The cache is updated by const member functions, so unlike basic_zstring_view a basic_lazy_zstring_view must not be
+// used from several threads at once without synchronization.
+
+namespace std {
+    template<class charT, class traits = char_traits<charT>>
+    class basic_lazy_zstring_view;
+
+    namespace ranges {
+        template<class charT, class traits>
+            constexpr bool enable_view<basic_lazy_zstring_view<charT, traits>> = true;
+        template<class charT, class traits>
+            constexpr bool enable_borrowed_range<basic_lazy_zstring_view<charT, traits>> = true;
+    }
+
+    // basic_lazy_zstring_view typedef-names
+    using lazy_zstring_view    = basic_lazy_zstring_view<char>;
+    using u8lazy_zstring_view  = basic_lazy_zstring_view<char8_t>;
+    using u16lazy_zstring_view = basic_lazy_zstring_view<char16_t>;
+    using u32lazy_zstring_view = basic_lazy_zstring_view<char32_t>;
+    using wlazy_zstring_view   = basic_lazy_zstring_view<wchar_t>;
+
+    // hash support
+    template<class charT, class traits> struct hash<basic_lazy_zstring_view<charT, traits>>;
+}
+
+namespace std::__zsv {
+    // The length of a null-terminated string, or max if that is smaller, without reading past str[max - 1]
+    template<class charT, class traits>
+    constexpr size_t __bounded_length(const charT* str, size_t max) noexcept {
+        if(!is_constant_evaluated() && __is_default_traits<charT, traits>) {
+            if constexpr(is_same_v<charT, char> || is_same_v<charT, char8_t>) {
+                return ::strnlen(reinterpret_cast<const char*>(str), max);
+            } else if constexpr(is_same_v<charT, wchar_t>) {
+                return ::wcsnlen(str, max);
+            }
+        }
+        size_t i = 0;
+        while(i < max && !traits::eq(str[i], charT())) {
+            i++;
+        }
+        return i;
+    }
+
+    // Index of the first code unit of a null-terminated string equal to c, which must not be the terminator, or npos
+    template<class charT, class traits>
+    constexpr size_t __find_before_terminator(const charT* str, charT c) noexcept {
+        constexpr size_t npos = basic_string_view<charT, traits>::npos;
+        if(!is_constant_evaluated() && __is_default_traits<charT, traits>) {
+            if constexpr(is_same_v<charT, char> || is_same_v<charT, char8_t>) {
+                const char* p = ::strchr(reinterpret_cast<const char*>(str), static_cast<char>(c));
+                return p ? p - reinterpret_cast<const char*>(str) : npos;
+            } else if constexpr(is_same_v<charT, wchar_t> && sizeof(wchar_t) == 4) {
+                const wchar_t* p = ::wcschr(str, c);
+                return p ? p - str : npos;
+            } else if constexpr(__use_scan_kernels<charT, traits>) {
+                const size_t pos = __find_unit_or_terminator(str, c);
+                return str[pos] == c ? pos : npos;
+            }
+        }
+        for(size_t i = 0; !traits::eq(str[i], charT()); i++) {
+            if(traits::eq(str[i], c)) {
+                return i;
+            }
+        }
+        return npos;
+    }
+}
+
+namespace std {
+    template<class charT, class traits /* = char_traits<charT> */>
+    class basic_lazy_zstring_view {
+    public:
+        // types
+        using zstring_view_type      = basic_zstring_view<charT, traits>;
+        using string_view_type       = basic_string_view<charT, traits>;
+        using traits_type            = traits;
+        using value_type             = charT;
+        using pointer                = value_type*;
+        using const_pointer          = const value_type*;
+        using reference              = value_type&;
+        using const_reference        = const value_type&;
+        using const_iterator         = const charT*;
+        using iterator               = const_iterator;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        using reverse_iterator       = const_reverse_iterator;
+        using size_type              = size_t;
+        using difference_type        = ptrdiff_t;
+        static constexpr size_type npos = size_type(-1);
+
+        // construction and assignment
+        constexpr basic_lazy_zstring_view() noexcept : data_(empty_string), size_(0) {}
+        constexpr basic_lazy_zstring_view(const basic_lazy_zstring_view&) noexcept = default;
+        constexpr basic_lazy_zstring_view& operator=(const basic_lazy_zstring_view&) noexcept = default;
+        constexpr basic_lazy_zstring_view(const charT* str) noexcept : data_(str), size_(npos) {}
+        basic_lazy_zstring_view(nullptr_t) = delete;
+        constexpr basic_lazy_zstring_view(zstring_view_type str) noexcept : data_(str.data()), size_(str.size()) {}
+        template<class Traits, class Allocator>
+        constexpr basic_lazy_zstring_view(const basic_string<charT, Traits, Allocator>& str) noexcept
+            : data_(str.c_str()), size_(str.size()) {}
+
+        // iterator support
+        constexpr const_iterator begin() const noexcept {
+            return data_;
+        }
+        constexpr const_iterator end() const noexcept {
+            return data_ + size();
+        }
+        constexpr const_iterator cbegin() const noexcept {
+            return begin();
+        }
+        constexpr const_iterator cend() const noexcept {
+            return end();
+        }
+        constexpr const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+        constexpr const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+        constexpr const_reverse_iterator crbegin() const noexcept {
+            return rbegin();
+        }
+        constexpr const_reverse_iterator crend() const noexcept {
+            return rend();
+        }
+
+        // capacity
+        constexpr size_type size() const noexcept {
+            if(size_ == npos) {
+                size_ = __zsv::__length<charT, traits>(data_);
+            }
+            return size_;
+        }
+        constexpr size_type length() const noexcept {
+            return size();
+        }
+        // Doesn't need the length
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return size_known() ? size_ == 0 : traits::eq(data_[0], charT());
+        }
+        // Whether the length has been computed
+        constexpr bool size_known() const noexcept {
+            return size_ != npos;
+        }
+
+        // element access, pos must not be past the terminator
+        constexpr const_reference operator[](size_type pos) const noexcept {
+            return data_[pos];
+        }
+        constexpr const_pointer data() const noexcept {
+            return data_;
+        }
+        constexpr const_pointer c_str() const noexcept {
+            return data_;
+        }
+
+        constexpr zstring_view_type view() const noexcept {
+            return zstring_view_type(data_, size());
+        }
+        constexpr operator zstring_view_type() const noexcept {
+            return view();
+        }
+        constexpr operator string_view_type() const noexcept {
+            return string_view_type(data_, size());
+        }
+
+        constexpr void swap(basic_lazy_zstring_view& s) noexcept {
+            std::swap(data_, s.data_);
+            std::swap(size_, s.size_);
+        }
+
+        // operations
+        constexpr int compare(string_view_type s) const noexcept {
+            if(size_known()) {
+                return string_view_type(data_, size_).compare(s);
+            }
+            // Either the string is no longer than s and its length is found, or only s.size() code units are compared
+            const size_type n = __zsv::__bounded_length<charT, traits>(data_, s.size() + 1);
+            if(n <= s.size()) {
+                size_ = n;
+                return string_view_type(data_, n).compare(s);
+            }
+            const int result = traits::compare(data_, s.data(), s.size());
+            return result != 0 ? result : 1;
+        }
+        constexpr int compare(const basic_lazy_zstring_view& s) const noexcept {
+            if(s.size_known()) {
+                return compare(string_view_type(s.data_, s.size_));
+            }
+            if(size_known()) {
+                return -s.compare(string_view_type(data_, size_));
+            }
+            for(size_type i = 0; ; i++) {
+                if(!traits::eq(data_[i], s.data_[i])) {
+                    return traits::lt(data_[i], s.data_[i]) ? -1 : 1;
+                }
+                if(traits::eq(data_[i], charT())) {
+                    size_ = i;
+                    s.size_ = i;
+                    return 0;
+                }
+            }
+        }
+
+        constexpr bool starts_with(string_view_type x) const noexcept {
+            if(size_known()) {
+                return string_view_type(data_, size_).starts_with(x);
+            }
+            const size_type n = __zsv::__bounded_length<charT, traits>(data_, x.size());
+            if(n < x.size()) {
+                size_ = n;
+                return false;
+            }
+            return traits::compare(data_, x.data(), x.size()) == 0;
+        }
+        // A view constructed with its size can contain null characters, one that computes its length can't
+        constexpr bool starts_with(charT x) const noexcept {
+            if(size_known()) {
+                return size_ != 0 && traits::eq(data_[0], x);
+            }
+            return !traits::eq(x, charT()) && traits::eq(data_[0], x);
+        }
+        constexpr bool starts_with(const charT* x) const noexcept {
+            return starts_with(string_view_type(x));
+        }
+
+        constexpr size_type find(charT c, size_type pos = 0) const noexcept {
+            if(size_known() || pos != 0) {
+                return view().find(c, pos);
+            }
+            if(traits::eq(c, charT())) {
+                return npos;
+            }
+            return __zsv::__find_before_terminator<charT, traits>(data_, c);
+        }
+        constexpr bool contains(charT c) const noexcept {
+            return find(c) != npos;
+        }
+
+        // comparison
+        friend constexpr bool operator==(const basic_lazy_zstring_view& x, const basic_lazy_zstring_view& y) noexcept {
+            if(x.size_known() && y.size_known() && x.size_ != y.size_) {
+                return false;
+            }
+            return x.compare(y) == 0;
+        }
+        friend constexpr auto operator<=>(const basic_lazy_zstring_view& x, const basic_lazy_zstring_view& y) noexcept {
+            return static_cast<comparison_category>(x.compare(y) <=> 0);
+        }
+        template<class T>
+            requires (!is_same_v<T, basic_lazy_zstring_view>) && is_convertible_v<const T&, string_view_type>
+        friend constexpr bool operator==(const basic_lazy_zstring_view& x, const T& y) noexcept {
+            const string_view_type str = y;
+            if(!x.size_known()) {
+                const size_type n = __zsv::__bounded_length<charT, traits>(x.data_, str.size() + 1);
+                if(n <= str.size()) {
+                    x.size_ = n;
+                }
+                return n == str.size() && traits::compare(x.data_, str.data(), n) == 0;
+            }
+            return x.size_ == str.size() && traits::compare(x.data_, str.data(), str.size()) == 0;
+        }
+        template<class T>
+            requires (!is_same_v<T, basic_lazy_zstring_view>) && is_convertible_v<const T&, string_view_type>
+        friend constexpr auto operator<=>(const basic_lazy_zstring_view& x, const T& y) noexcept {
+            return static_cast<comparison_category>(x.compare(string_view_type(y)) <=> 0);
+        }
+
+    private:
+        using comparison_category = decltype(string_view_type() <=> string_view_type());
+
+        static constexpr charT empty_string[1]{};
+
+        const charT* data_;
+        mutable size_type size_; // npos until computed
+    };
+
+    template<class charT, class traits>
+    basic_ostream<charT, traits>& operator<<(basic_ostream<charT, traits>& os, basic_lazy_zstring_view<charT, traits> str) {
+        return os<<str.view();
+    }
+
+    // Hashes like basic_zstring_view
+    template<class charT, class traits>
+    struct hash<basic_lazy_zstring_view<charT, traits>> {
+        auto operator()(const basic_lazy_zstring_view<charT, traits>& str) const noexcept {
+            return std::hash<basic_string_view<charT, traits>>{}(str);
+        }
+    };
+
+    // [format.formatter.spec]
+    template<class charT, class traits>
+    struct formatter<basic_lazy_zstring_view<charT, traits>, charT> : formatter<basic_zstring_view<charT, traits>, charT> {
+        template<typename _Out>
+        auto format(basic_lazy_zstring_view<charT, traits> str, basic_format_context<_Out, charT>& context) const {
+            return formatter<basic_zstring_view<charT, traits>, charT>::format(str.view(), context);
+        }
+    };
+}
+
+#endif
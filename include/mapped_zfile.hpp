@@ -0,0 +1,220 @@
+#ifndef MAPPED_ZFILE_HPP
+#define MAPPED_ZFILE_HPP
+
+#include "zstring_view.hpp"
+#include "zstring_split.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// NOTE: Not part of proposal. POSIX only. mapped_zfile maps a file read-only and privately so that its contents can be
+// used as a zstring_view without copying. The mapping is placed in a reservation one page longer than the file, so a
+// zero byte always follows the last byte of the file. If the file ends on a page boundary the extra anonymous page
+// provides the terminator. Otherwise the kernel zero-fills the rest of the file's last page, but until that page is
+// written it is shared with the page cache and bytes appended to the file later would show through, so the terminator
+// is written once to give the mapping its own copy of the page. Files that report a size of 0,
+// such as those in /proc, are read into an anonymous mapping of the same layout instead, since their contents are
+// generated when read.
+//
+// As with any file mapping, truncating the file while it is mapped makes accesses past the new end raise SIGBUS.
+
+namespace std {
+    class mapped_zfile {
+    public:
+        using size_type = size_t;
+
+        // Passed to madvise for the file's pages
+        enum class access_hint {
+            normal,
+            sequential,
+            random,
+            willneed
+        };
+
+        explicit mapped_zfile(zstring_view path, access_hint hint = access_hint::sequential) {
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if(fd == -1) {
+                throw_errno("open");
+            }
+            try {
+                map(fd, hint);
+            } catch(...) {
+                unmap();
+                ::close(fd);
+                throw;
+            }
+            ::close(fd);
+        }
+        mapped_zfile(const mapped_zfile&) = delete;
+        mapped_zfile& operator=(const mapped_zfile&) = delete;
+        mapped_zfile(mapped_zfile&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+              reserved_(std::exchange(other.reserved_, 0)), writable_(std::exchange(other.writable_, false)) {}
+        mapped_zfile& operator=(mapped_zfile&& other) noexcept {
+            if(this != &other) {
+                unmap();
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+                reserved_ = std::exchange(other.reserved_, 0);
+                writable_ = std::exchange(other.writable_, false);
+            }
+            return *this;
+        }
+        ~mapped_zfile() {
+            unmap();
+        }
+
+        // The contents of the file
+        zstring_view view() const noexcept {
+            return data_ ? zstring_view(data_, size_) : zstring_view();
+        }
+        operator zstring_view() const noexcept {
+            return view();
+        }
+        size_type size() const noexcept {
+            return size_;
+        }
+        [[nodiscard]] bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        // The lines of the file, as by views::zsplit(..., '\n'): each line is terminated in place as iteration reaches
+        // it, so afterwards view() contains the terminators instead of the newlines. Pages are copied on write and the
+        // file itself is never modified. Since the newlines are gone, this can be called once; later calls throw
+        // logic_error.
+        ranges::zsplit_view<char> lines() {
+            if(writable_) {
+                throw logic_error("mapped_zfile::lines: the lines have already been split");
+            }
+            if(::mprotect(data_, reserved_, PROT_READ | PROT_WRITE) != 0) {
+                throw_errno("mprotect");
+            }
+            #ifdef MADV_POPULATE_WRITE
+            // Copy all the pages up front instead of taking a write fault per page. Best effort, older kernels reject
+            // the advice.
+            ::madvise(data_, size_, MADV_POPULATE_WRITE);
+            #endif
+            writable_ = true;
+            return ranges::zsplit_view<char>(span<char>(data_, size_), '\n');
+        }
+
+        // Changes the access pattern advice for the file's pages
+        void advise(access_hint hint) {
+            if(size_ != 0 && ::madvise(data_, size_, advice(hint)) != 0) {
+                throw_errno("madvise");
+            }
+        }
+
+    private:
+        [[noreturn]] static void throw_errno(const char* what) {
+            throw system_error(errno, system_category(), string("mapped_zfile: ") + what);
+        }
+
+        static int advice(access_hint hint) noexcept {
+            switch(hint) {
+                case access_hint::sequential:
+                    return MADV_SEQUENTIAL;
+                case access_hint::random:
+                    return MADV_RANDOM;
+                case access_hint::willneed:
+                    return MADV_WILLNEED;
+                default:
+                    return MADV_NORMAL;
+            }
+        }
+
+        void map(int fd, access_hint hint) {
+            struct stat info;
+            if(::fstat(fd, &info) != 0) {
+                throw_errno("fstat");
+            }
+            if(info.st_size == 0) {
+                read(fd);
+                return;
+            }
+            const size_t size = static_cast<size_t>(info.st_size);
+            reserve(size, PROT_READ);
+            if(::mmap(data_, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+                throw_errno("mmap");
+            }
+            const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            if(size % page != 0) {
+                // Copy the last page on write so that the file growing can't overwrite the terminator
+                char* last = data_ + size / page * page;
+                if(::mprotect(last, page, PROT_READ | PROT_WRITE) != 0) {
+                    throw_errno("mprotect");
+                }
+                data_[size] = '\0';
+                if(::mprotect(last, page, PROT_READ) != 0) {
+                    throw_errno("mprotect");
+                }
+            }
+            size_ = size;
+            advise(hint);
+        }
+
+        // For files whose size isn't known up front. An empty regular file ends up with an empty reservation.
+        void read(int fd) {
+            string contents;
+            char buffer[4096];
+            while(true) {
+                const ssize_t n = ::read(fd, buffer, sizeof(buffer));
+                if(n == 0) {
+                    break;
+                }
+                if(n == -1) {
+                    if(errno == EINTR) {
+                        continue;
+                    }
+                    throw_errno("read");
+                }
+                contents.append(buffer, static_cast<size_t>(n));
+            }
+            reserve(contents.size(), PROT_READ | PROT_WRITE);
+            contents.copy(data_, contents.size());
+            if(::mprotect(data_, reserved_, PROT_READ) != 0) {
+                throw_errno("mprotect");
+            }
+            size_ = contents.size();
+        }
+
+        // Anonymous zero-filled pages for size bytes and at least one terminator
+        void reserve(size_t size, int protection) {
+            const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            const size_t reserved = (size + page - 1) / page * page + page;
+            void* reservation = ::mmap(nullptr, reserved, protection, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if(reservation == MAP_FAILED) {
+                throw_errno("mmap");
+            }
+            data_ = static_cast<char*>(reservation);
+            reserved_ = reserved;
+        }
+
+        void unmap() noexcept {
+            if(data_) {
+                ::munmap(data_, reserved_);
+            }
+            data_ = nullptr;
+            size_ = 0;
+            reserved_ = 0;
+            writable_ = false;
+        }
+
+        char* data_ = nullptr;
+        size_t size_ = 0;
+        size_t reserved_ = 0; // length of the whole reservation, including the terminator page
+        bool writable_ = false;
+    };
+}
+
+#endif
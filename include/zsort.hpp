@@ -0,0 +1,334 @@
+#ifndef ZSORT_HPP
+#define ZSORT_HPP
+
+#include "zstring_view.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <execution>
+#include <future>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// NOTE: Not part of proposal. zsort sorts basic_zstring_views with multikey quicksort: strings are partitioned three
+// ways on the next few code units rather than compared in full, so the common prefix of a group of strings is looked at
+// once instead of in every comparison. The next 8 bytes of each string are cached next to it as an integer key, so a
+// partitioning pass compares integers without dereferencing the strings.
+//
+//     std::vector<std::zstring_view> paths = ...;
+//     std::vector<size_t> lcp(paths.size());
+//     std::zsort(paths, lcp);
+//     paths.resize(std::zunique(paths, lcp));
+//
+// The order is that of operator<=>. With an lcp span the length of the longest common prefix of each string and the
+// one before it is written too (0 for the first), which zunique uses to drop duplicates without comparing them again.
+// zsort(std::execution::par, ...) sorts large partitions on several threads. Views with custom traits are sorted with
+// std::sort.
+
+namespace std::__zsv {
+    template<class T>
+    inline constexpr bool __is_zstring_view = false;
+    template<class charT, class traits>
+    inline constexpr bool __is_zstring_view<basic_zstring_view<charT, traits>> = true;
+
+    template<class R>
+    concept __zstring_view_sortable = ranges::contiguous_range<R> && ranges::sized_range<R>
+        && __is_zstring_view<ranges::range_value_t<R>> && !is_const_v<remove_reference_t<ranges::range_reference_t<R>>>;
+
+    template<class R>
+    using __zsort_view_t = ranges::range_value_t<R>;
+
+    // A string and the code units at the current depth packed into an integer, big-endian so that integer order is
+    // string order. Code units past the end are zero. Signed code units have the sign bit flipped so that they order as
+    // traits::lt does.
+    template<class View>
+    struct __zsort_entry {
+        using char_type = typename View::value_type;
+        static constexpr size_t units = 8 / sizeof(char_type); // code units in a key
+        static constexpr size_t unit_bits = 8 * sizeof(char_type);
+
+        uint64_t key;
+        View str;
+
+        static constexpr uint64_t unit(char_type c) noexcept {
+            const uint64_t value = __unit(c);
+            return is_signed_v<char_type> && sizeof(char_type) > 1 ? value ^ (uint64_t(1) << (unit_bits - 1)) : value;
+        }
+
+        static uint64_t load(View str, size_t depth) noexcept {
+            const char_type* data = str.data() + depth;
+            const size_t available = str.size() > depth ? str.size() - depth : 0;
+            if constexpr(sizeof(char_type) == 1) {
+                if(available >= 8 && endian::native == endian::little) {
+                    uint64_t value;
+                    memcpy(&value, data, 8);
+                    return byteswap(value);
+                }
+            }
+            uint64_t key = 0;
+            const size_t count = std::min(available, units);
+            for(size_t i = 0; i < count; i++) {
+                key |= unit(data[i]) << (unit_bits * (units - 1 - i));
+            }
+            return key;
+        }
+
+        void reload(size_t depth) noexcept {
+            key = load(str, depth);
+        }
+
+        // Whether the string ends within the key at depth
+        bool ends_within(size_t depth) const noexcept {
+            return str.size() <= depth + units;
+        }
+    };
+
+    // Length of the common prefix of x and y, which are known to agree on the first from code units
+    template<class View>
+    size_t __common_prefix(View x, View y, size_t from) noexcept {
+        using entry = __zsort_entry<View>;
+        const size_t limit = std::min(x.size(), y.size());
+        size_t i = from;
+        while(i < limit) {
+            const uint64_t difference = entry::load(x, i) ^ entry::load(y, i);
+            if(difference != 0) {
+                return std::min(limit, i + countl_zero(difference) / entry::unit_bits);
+            }
+            i += entry::units;
+        }
+        return limit;
+    }
+
+    template<class View>
+    bool __zsort_less(const __zsort_entry<View>& x, const __zsort_entry<View>& y, size_t depth) noexcept {
+        if(x.key != y.key) {
+            return x.key < y.key;
+        }
+        if(x.ends_within(depth) || y.ends_within(depth)) {
+            // Equal keys, so the string that ends first is a prefix of the other
+            return x.str.size() < y.str.size();
+        }
+        const size_t from = depth + __zsort_entry<View>::units;
+        using string_view_type = basic_string_view<typename View::value_type, typename View::traits_type>;
+        return string_view_type(x.str.data() + from, x.str.size() - from)
+            < string_view_type(y.str.data() + from, y.str.size() - from);
+    }
+
+    inline constexpr size_t __zsort_insertion_threshold = 16;
+    inline constexpr size_t __zsort_parallel_threshold = 1 << 15;
+
+    // Sorts a[0, n), whose strings all agree on their first depth code units and whose keys are loaded at depth. If lcp
+    // isn't null, fills lcp[1, n). spawn_levels is how many more levels of recursion may hand partitions to other
+    // threads. The less and greater partitions are sorted recursively, and the equal one, a key further in, by the next
+    // iteration, so that strings sharing a long prefix don't take a stack frame per key.
+    template<class View>
+    void __zsort(__zsort_entry<View>* a, size_t* lcp, size_t n, size_t depth, int spawn_levels) {
+        using entry = __zsort_entry<View>;
+        while(n > 1) {
+            if(n <= __zsort_insertion_threshold) {
+                for(size_t i = 1; i < n; i++) {
+                    entry value = std::move(a[i]);
+                    size_t j = i;
+                    for(; j > 0 && __zsort_less(value, a[j - 1], depth); j--) {
+                        a[j] = std::move(a[j - 1]);
+                    }
+                    a[j] = std::move(value);
+                }
+                if(lcp) {
+                    for(size_t i = 1; i < n; i++) {
+                        lcp[i] = __common_prefix(a[i - 1].str, a[i].str, depth);
+                    }
+                }
+                return;
+            }
+
+            // Three-way partition on the median of three keys
+            uint64_t pivot;
+            {
+                const uint64_t x = a[0].key, y = a[n / 2].key, z = a[n - 1].key;
+                pivot = std::max(std::min(x, y), std::min(std::max(x, y), z));
+            }
+            size_t lt = 0, i = 0, gt = n;
+            while(i < gt) {
+                if(a[i].key < pivot) {
+                    std::swap(a[lt++], a[i++]);
+                } else if(a[i].key > pivot) {
+                    std::swap(a[i], a[--gt]);
+                } else {
+                    i++;
+                }
+            }
+
+            // Within the equal partition, strings that end within the key are prefixes of the others and of each other
+            entry* equal = a + lt;
+            const size_t equal_size = gt - lt;
+            entry* unfinished = std::partition(equal, equal + equal_size, [depth](const entry& e) {
+                return e.ends_within(depth);
+            });
+            const size_t finished_size = unfinished - equal;
+            const size_t unfinished_size = equal_size - finished_size;
+            std::sort(equal, unfinished, [](const entry& x, const entry& y) {
+                return x.str.size() < y.str.size();
+            });
+            for(entry* e = unfinished; e != equal + equal_size; e++) {
+                e->reload(depth + entry::units);
+            }
+
+            auto sort_part = [lcp, depth, spawn_levels](entry* part, size_t offset, size_t size) {
+                __zsort(part, lcp ? lcp + offset : nullptr, size, depth, spawn_levels - 1);
+            };
+            future<void> less_task, greater_task;
+            if(spawn_levels > 0 && n >= __zsort_parallel_threshold) {
+                if(lt >= __zsort_parallel_threshold / 2) {
+                    less_task = async(launch::async, sort_part, a, 0, lt);
+                }
+                if(n - gt >= __zsort_parallel_threshold / 2) {
+                    greater_task = async(launch::async, sort_part, a + gt, gt, n - gt);
+                }
+            }
+            if(!less_task.valid()) {
+                sort_part(a, 0, lt);
+            }
+            if(!greater_task.valid()) {
+                sort_part(a + gt, gt, n - gt);
+            }
+            if(less_task.valid()) {
+                less_task.get();
+            }
+            if(greater_task.valid()) {
+                greater_task.get();
+            }
+
+            if(lcp) {
+                for(size_t k = lt + 1; k < lt + finished_size; k++) {
+                    lcp[k] = a[k - 1].str.size();
+                }
+                if(finished_size > 0 && unfinished_size > 0) {
+                    lcp[lt + finished_size] = a[lt + finished_size - 1].str.size();
+                }
+                // Across the partition boundaries the strings differ within the key at depth, where the equal
+                // partition's strings all agree, so these don't depend on how that partition ends up ordered
+                if(lt > 0 && lt < n) {
+                    lcp[lt] = __common_prefix(a[lt - 1].str, a[lt].str, depth);
+                }
+                if(gt > 0 && gt < n) {
+                    lcp[gt] = __common_prefix(a[gt - 1].str, a[gt].str, depth);
+                }
+            }
+
+            a = unfinished;
+            lcp = lcp ? lcp + lt + finished_size : nullptr;
+            n = unfinished_size;
+            depth += entry::units;
+            spawn_levels--;
+        }
+    }
+
+    template<class View>
+    void __zsort(span<View> strings, size_t* lcp, int spawn_levels) {
+        if(lcp && !strings.empty()) {
+            lcp[0] = 0;
+        }
+        if constexpr(!__is_default_traits<typename View::value_type, typename View::traits_type>) {
+            std::sort(strings.begin(), strings.end());
+            if(lcp) {
+                for(size_t i = 1; i < strings.size(); i++) {
+                    size_t k = 0;
+                    const size_t limit = std::min(strings[i - 1].size(), strings[i].size());
+                    while(k < limit && View::traits_type::eq(strings[i - 1][k], strings[i][k])) {
+                        k++;
+                    }
+                    lcp[i] = k;
+                }
+            }
+        } else {
+            using entry = __zsort_entry<View>;
+            const unique_ptr<entry[]> entries(new entry[strings.size()]);
+            for(size_t i = 0; i < strings.size(); i++) {
+                entries[i] = entry{entry::load(strings[i], 0), strings[i]};
+            }
+            __zsort(entries.get(), lcp, strings.size(), 0, spawn_levels);
+            for(size_t i = 0; i < strings.size(); i++) {
+                strings[i] = entries[i].str;
+            }
+        }
+    }
+
+    // Enough levels of partitioning for every thread to get work, and then some for unbalanced partitions
+    inline int __zsort_spawn_levels() noexcept {
+        return bit_width(std::max(thread::hardware_concurrency(), 1u)) + 2;
+    }
+
+    template<class ExecutionPolicy>
+    inline constexpr bool __is_parallel_policy =
+        !is_same_v<remove_cvref_t<ExecutionPolicy>, execution::sequenced_policy>
+        && !is_same_v<remove_cvref_t<ExecutionPolicy>, execution::unsequenced_policy>;
+}
+
+namespace std {
+    // Sorts strings in ascending order
+    template<class R>
+        requires __zsv::__zstring_view_sortable<R>
+    void zsort(R&& strings) {
+        __zsv::__zsort(span<__zsv::__zsort_view_t<R>>(strings), nullptr, 0);
+    }
+    // Also writes the length of the common prefix of each string and the one before it to lcp, which must be as large
+    // as strings
+    template<class R>
+        requires __zsv::__zstring_view_sortable<R>
+    void zsort(R&& strings, span<size_t> lcp) {
+        assert(lcp.size() >= ranges::size(strings));
+        __zsv::__zsort(span<__zsv::__zsort_view_t<R>>(strings), lcp.data(), 0);
+    }
+
+    // Sorts large partitions concurrently unless policy is sequenced or unsequenced
+    template<class ExecutionPolicy, class R>
+        requires is_execution_policy_v<remove_cvref_t<ExecutionPolicy>> && __zsv::__zstring_view_sortable<R>
+    void zsort(ExecutionPolicy&&, R&& strings) {
+        const int spawn_levels = __zsv::__is_parallel_policy<ExecutionPolicy> ? __zsv::__zsort_spawn_levels() : 0;
+        __zsv::__zsort(span<__zsv::__zsort_view_t<R>>(strings), nullptr, spawn_levels);
+    }
+    template<class ExecutionPolicy, class R>
+        requires is_execution_policy_v<remove_cvref_t<ExecutionPolicy>> && __zsv::__zstring_view_sortable<R>
+    void zsort(ExecutionPolicy&&, R&& strings, span<size_t> lcp) {
+        assert(lcp.size() >= ranges::size(strings));
+        const int spawn_levels = __zsv::__is_parallel_policy<ExecutionPolicy> ? __zsv::__zsort_spawn_levels() : 0;
+        __zsv::__zsort(span<__zsv::__zsort_view_t<R>>(strings), lcp.data(), spawn_levels);
+    }
+
+    // Moves the first of each run of equal strings to the front, like std::unique, and returns how many there are
+    template<class R>
+        requires __zsv::__zstring_view_sortable<R>
+    size_t zunique(R&& strings) {
+        const span<__zsv::__zsort_view_t<R>> view(strings);
+        return std::unique(view.begin(), view.end()) - view.begin();
+    }
+    // Uses the lcp written by zsort: a string equals the one before it when the common prefix is all of both. lcp is
+    // compacted along with the strings, and stays correct for them.
+    template<class R>
+        requires __zsv::__zstring_view_sortable<R>
+    size_t zunique(R&& strings, span<size_t> lcp) {
+        const span<__zsv::__zsort_view_t<R>> view(strings);
+        assert(lcp.size() >= view.size());
+        size_t count = 0;
+        size_t previous_size = 0;
+        for(size_t i = 0; i < view.size(); i++) {
+            const size_t size = view[i].size();
+            if(i == 0 || lcp[i] != size || size != previous_size) {
+                view[count] = view[i];
+                lcp[count] = lcp[i];
+                count++;
+            }
+            previous_size = size;
+        }
+        return count;
+    }
+}
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef ZSTRING_ARENA_HPP
+#define ZSTRING_ARENA_HPP
+
+#include "zstring_view.hpp"
+#include "zstring_hash.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// NOTE: Not part of proposal. basic_zstring_arena copies strings that may not be null-terminated (e.g. string_views
+// sliced out of a network buffer) into chunked, bump-allocated storage, appends the terminator and hands back
+// basic_zstring_views. Storage is released in bulk: reset() makes every view handed out so far dangle but keeps the
+// chunks for reuse, so a per-request arena stops allocating once it has warmed up. In deduplicating mode equal strings
+// are stored once and get the same view.
+
+namespace std {
+    template<class charT, class traits = char_traits<charT>, class Allocator = allocator<charT>>
+    class basic_zstring_arena;
+
+    // basic_zstring_arena typedef-names
+    using zstring_arena    = basic_zstring_arena<char>;
+    using u8zstring_arena  = basic_zstring_arena<char8_t>;
+    using u16zstring_arena = basic_zstring_arena<char16_t>;
+    using u32zstring_arena = basic_zstring_arena<char32_t>;
+    using wzstring_arena   = basic_zstring_arena<wchar_t>;
+
+    template<class charT, class traits, class Allocator>
+    class basic_zstring_arena {
+        using alloc_traits = allocator_traits<Allocator>;
+
+    public:
+        // types
+        using traits_type       = traits;
+        using value_type        = charT;
+        using allocator_type    = Allocator;
+        using size_type         = size_t;
+        using zstring_view_type = basic_zstring_view<charT, traits>;
+        using string_view_type  = basic_string_view<charT, traits>;
+
+        // Chunk size, in code units, unless specified otherwise
+        static constexpr size_type default_chunk_size = 4096;
+
+        // construction and assignment
+        explicit basic_zstring_arena(
+            size_type chunk_size = default_chunk_size,
+            bool deduplicate = false,
+            const Allocator& alloc = Allocator()
+        ) : alloc_(alloc), chunks_(alloc), dedicated_(alloc), chunk_size_(std::max<size_type>(chunk_size, 1)), deduplicate_(deduplicate),
+            strings_(0, hash_type(), key_equal(), alloc) {}
+        basic_zstring_arena(const basic_zstring_arena&) = delete;
+        basic_zstring_arena& operator=(const basic_zstring_arena&) = delete;
+        // Views handed out by the source remain valid
+        basic_zstring_arena(basic_zstring_arena&& other) noexcept
+            : alloc_(other.alloc_), chunks_(std::move(other.chunks_)), current_(std::exchange(other.current_, 0)),
+              offset_(std::exchange(other.offset_, 0)), dedicated_(std::move(other.dedicated_)),
+              dedicated_used_(std::exchange(other.dedicated_used_, 0)), chunk_size_(other.chunk_size_),
+              deduplicate_(other.deduplicate_), strings_(std::move(other.strings_)) {
+            other.chunks_.clear();
+            other.dedicated_.clear();
+            other.strings_.clear();
+        }
+        // Would have to release this arena's storage and reconcile allocators; move-construct a new arena instead
+        basic_zstring_arena& operator=(basic_zstring_arena&&) = delete;
+        ~basic_zstring_arena() {
+            release();
+        }
+
+        // Copies str and returns a view of the null-terminated copy
+        zstring_view_type store(string_view_type str) {
+            if(deduplicate_) {
+                if(auto it = strings_.find(str); it != strings_.end()) {
+                    return *it;
+                }
+            }
+            charT* data = allocate_units(str.size() + 1);
+            traits::copy(data, str.data(), str.size());
+            traits::assign(data[str.size()], charT());
+            zstring_view_type result(data, str.size());
+            if(deduplicate_) {
+                strings_.insert(result);
+            }
+            return result;
+        }
+
+        // Copies the pieces back to back and returns a view of the null-terminated result
+        template<class... Pieces>
+            requires (is_convertible_v<const Pieces&, string_view_type> && ...)
+        zstring_view_type concat(const Pieces&... pieces) {
+            const string_view_type views[] = {string_view_type(pieces)...};
+            size_type size = 0;
+            for(auto view : views) {
+                size += view.size();
+            }
+            if(deduplicate_ && size >= chunk_size_) {
+                // A dedicated chunk can't be given back when the result turns out to be a duplicate, so the pieces are
+                // joined outside the arena and looked up first
+                basic_string<charT, traits, Allocator> joined(alloc_);
+                joined.reserve(size);
+                for(auto view : views) {
+                    joined.append(view);
+                }
+                return store(joined);
+            }
+            charT* data = allocate_units(size + 1);
+            charT* out = data;
+            for(auto view : views) {
+                traits::copy(out, view.data(), view.size());
+                out += view.size();
+            }
+            traits::assign(*out, charT());
+            zstring_view_type result(data, size);
+            if(deduplicate_) {
+                if(auto it = strings_.find(result); it != strings_.end()) {
+                    // Give the space back if it was the last thing bump-allocated
+                    if(current_ < chunks_.size() && data + size + 1 == chunks_[current_].data + offset_) {
+                        offset_ -= size + 1;
+                    }
+                    return *it;
+                }
+                strings_.insert(result);
+            }
+            return result;
+        }
+
+        // n contiguous code units of uninitialized storage, for callers that write a string in place. The result is
+        // neither terminated nor deduplicated.
+        charT* allocate(size_type n) {
+            return allocate_units(n);
+        }
+
+        // Invalidates every view handed out so far and makes all storage available again without freeing it
+        void reset() noexcept {
+            current_ = 0;
+            offset_ = 0;
+            dedicated_used_ = 0;
+            strings_.clear();
+        }
+
+        // Invalidates every view handed out so far and frees all storage
+        void release() noexcept {
+            for(auto& chunk : chunks_) {
+                alloc_traits::deallocate(alloc_, chunk.data, chunk.size);
+            }
+            for(auto& chunk : dedicated_) {
+                alloc_traits::deallocate(alloc_, chunk.data, chunk.size);
+            }
+            chunks_.clear();
+            dedicated_.clear();
+            reset();
+        }
+
+        // observers
+        bool deduplicating() const noexcept {
+            return deduplicate_;
+        }
+        size_type chunk_size() const noexcept {
+            return chunk_size_;
+        }
+        // Code units of storage owned by the arena
+        size_type capacity() const noexcept {
+            size_type capacity = 0;
+            for(const auto& chunk : chunks_) {
+                capacity += chunk.size;
+            }
+            for(const auto& chunk : dedicated_) {
+                capacity += chunk.size;
+            }
+            return capacity;
+        }
+        allocator_type get_allocator() const noexcept {
+            return alloc_;
+        }
+
+    private:
+        struct chunk {
+            charT* data;
+            size_type size;
+        };
+        using hash_type = basic_zstring_hash<charT, traits>;
+        using key_equal = basic_zstring_equal<charT, traits>;
+        using chunk_allocator = typename alloc_traits::template rebind_alloc<chunk>;
+        using set_allocator = typename alloc_traits::template rebind_alloc<zstring_view_type>;
+
+        // n contiguous code units. Chunks are filled in order, a string that doesn't fit in what is left of the current
+        // one moves on to the next, and strings larger than the chunk size get a dedicated chunk. Dedicated chunks are
+        // kept apart so that small strings never fill them, and after a reset each oversized string takes the smallest
+        // free one that is large enough, so storing the same sizes again doesn't allocate.
+        charT* allocate_units(size_type n) {
+            if(current_ < chunks_.size() && chunks_[current_].size - offset_ >= n) {
+                charT* data = chunks_[current_].data + offset_;
+                offset_ += n;
+                return data;
+            }
+            if(n > chunk_size_) {
+                // dedicated_[0, dedicated_used_) are in use, the rest are free
+                const size_type none = dedicated_.size();
+                size_type best = none;
+                for(size_type i = dedicated_used_; i < dedicated_.size(); i++) {
+                    if(dedicated_[i].size >= n && (best == none || dedicated_[i].size < dedicated_[best].size)) {
+                        best = i;
+                    }
+                }
+                if(best == none) {
+                    dedicated_.reserve(dedicated_.size() + 1);
+                    dedicated_.push_back({alloc_traits::allocate(alloc_, n), n});
+                }
+                std::swap(dedicated_[dedicated_used_], dedicated_[best]);
+                return dedicated_[dedicated_used_++].data;
+            }
+            while(++current_ < chunks_.size()) {
+                if(chunks_[current_].size >= n) {
+                    offset_ = n;
+                    return chunks_[current_].data;
+                }
+            }
+            chunks_.reserve(chunks_.size() + 1);
+            chunks_.push_back({alloc_traits::allocate(alloc_, chunk_size_), chunk_size_});
+            current_ = chunks_.size() - 1;
+            offset_ = n;
+            return chunks_[current_].data;
+        }
+
+        [[no_unique_address]] Allocator alloc_;
+        vector<chunk, chunk_allocator> chunks_;
+        size_type current_ = 0; // chunk being filled
+        size_type offset_ = 0;  // code units used in the current chunk
+        vector<chunk, chunk_allocator> dedicated_; // chunks for strings larger than chunk_size_
+        size_type dedicated_used_ = 0;
+        size_type chunk_size_;
+        bool deduplicate_;
+        unordered_set<zstring_view_type, hash_type, key_equal, set_allocator> strings_;
+    };
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef ZSTRING_BUFFER_HPP
+#define ZSTRING_BUFFER_HPP
+
+#include "zstring_view.hpp"
+
+#include <concepts>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+// NOTE: Not part of proposal. basic_zstring_buffer provides a null-terminated version of a string for a C API call. A
+// basic_string_view is copied, into inline storage when it fits and onto the heap otherwise. Strings already known to
+// be terminated (basic_zstring_view, basic_string, const charT*) are referenced without copying, and must outlive the
+// buffer. c_str_of wraps construction:
+//
+//     ::stat(std::c_str_of(path).c_str(), &info);
+
+namespace std {
+    template<class charT, size_t N = 256, class traits = char_traits<charT>>
+    class basic_zstring_buffer;
+
+    // basic_zstring_buffer typedef-names
+    using zstring_buffer    = basic_zstring_buffer<char>;
+    using u8zstring_buffer  = basic_zstring_buffer<char8_t>;
+    using u16zstring_buffer = basic_zstring_buffer<char16_t>;
+    using u32zstring_buffer = basic_zstring_buffer<char32_t>;
+    using wzstring_buffer   = basic_zstring_buffer<wchar_t>;
+
+    template<class charT, size_t N, class traits>
+    class basic_zstring_buffer {
+        static_assert(N > 0, "the inline storage needs room for the terminator");
+
+    public:
+        // types
+        using traits_type       = traits;
+        using value_type        = charT;
+        using size_type         = size_t;
+        using zstring_view_type = basic_zstring_view<charT, traits>;
+        using string_view_type  = basic_string_view<charT, traits>;
+
+        // Code units, including the terminator, that fit without allocating
+        static constexpr size_type inline_capacity = N;
+
+        // construction, the view may point into the buffer so it can be neither copied nor moved
+        basic_zstring_buffer(zstring_view_type str) noexcept : view_(str) {}
+        template<class Traits, class Allocator>
+        basic_zstring_buffer(const basic_string<charT, Traits, Allocator>& str) noexcept
+            : view_(str.c_str(), str.size()) {}
+        basic_zstring_buffer(const charT* str) : view_(str) {}
+        basic_zstring_buffer(nullptr_t) = delete;
+        template<class T>
+            requires is_convertible_v<const T&, string_view_type> && (!is_convertible_v<const T&, zstring_view_type>)
+                && (!is_convertible_v<const T&, const charT*>)
+        basic_zstring_buffer(const T& str) {
+            const string_view_type view = str;
+            charT* data = storage_;
+            if(view.size() >= N) {
+                heap_ = make_unique_for_overwrite<charT[]>(view.size() + 1);
+                data = heap_.get();
+            }
+            traits::copy(data, view.data(), view.size());
+            traits::assign(data[view.size()], charT());
+            view_ = zstring_view_type(data, view.size());
+        }
+        basic_zstring_buffer(const basic_zstring_buffer&) = delete;
+        basic_zstring_buffer& operator=(const basic_zstring_buffer&) = delete;
+
+        constexpr zstring_view_type view() const noexcept {
+            return view_;
+        }
+        constexpr operator zstring_view_type() const noexcept {
+            return view_;
+        }
+        constexpr const charT* c_str() const noexcept {
+            return view_.c_str();
+        }
+        constexpr const charT* data() const noexcept {
+            return view_.data();
+        }
+        constexpr size_type size() const noexcept {
+            return view_.size();
+        }
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return view_.empty();
+        }
+        // Whether the string was copied, rather than referenced in place
+        constexpr bool copied() const noexcept {
+            return view_.data() == storage_ || heap_;
+        }
+
+    private:
+        zstring_view_type view_;
+        unique_ptr<charT[]> heap_;
+        charT storage_[N];
+    };
+
+    // A null-terminated version of str; only copies when str is not already known to be terminated
+    template<size_t N = 256, class charT, class traits>
+    basic_zstring_buffer<charT, N, traits> c_str_of(basic_string_view<charT, traits> str) {
+        return basic_zstring_buffer<charT, N, traits>(str);
+    }
+    template<size_t N = 256, class charT, class traits>
+    basic_zstring_buffer<charT, N, traits> c_str_of(basic_zstring_view<charT, traits> str) noexcept {
+        return basic_zstring_buffer<charT, N, traits>(str);
+    }
+    template<size_t N = 256, class charT, class traits, class Allocator>
+    basic_zstring_buffer<charT, N, traits> c_str_of(const basic_string<charT, traits, Allocator>& str) noexcept {
+        return basic_zstring_buffer<charT, N, traits>(str);
+    }
+    template<size_t N = 256, class charT>
+    basic_zstring_buffer<charT, N> c_str_of(const charT* str) {
+        return basic_zstring_buffer<charT, N>(str);
+    }
+}
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef ZSTRING_HASH_HPP
+#define ZSTRING_HASH_HPP
+
+#include "zstring_view.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// NOTE: Not part of proposal. Transparent hash and equality function objects so that unordered containers keyed by
+// std::basic_string (or basic_zstring_view) can be probed with a basic_zstring_view, basic_string_view, or const charT*
+// without constructing a key, using C++20 heterogeneous lookup:
+//
+//     std::unordered_map<std::string, int, std::zstring_hash, std::zstring_equal> map;
+//     map.find("key"zsv); // no allocation
+//
+// Every argument is hashed as the basic_string_view it converts to. The hash algorithm is a policy, defaulting to
+// std::hash<basic_string_view>; zstring_wyhash is a faster non-cryptographic alternative.
+
+namespace std {
+    // wyhash (final version 4) over the bytes of a string, also usable in constant expressions
+    struct zstring_wyhash;
+
+    template<class charT, class traits = char_traits<charT>, class Hash = hash<basic_string_view<charT, traits>>>
+    struct basic_zstring_hash;
+    template<class charT, class traits = char_traits<charT>>
+    struct basic_zstring_equal;
+
+    // typedef-names
+    using zstring_hash       = basic_zstring_hash<char>;
+    using u8zstring_hash     = basic_zstring_hash<char8_t>;
+    using u16zstring_hash    = basic_zstring_hash<char16_t>;
+    using u32zstring_hash    = basic_zstring_hash<char32_t>;
+    using wzstring_hash      = basic_zstring_hash<wchar_t>;
+    using zstring_fast_hash    = basic_zstring_hash<char, char_traits<char>, zstring_wyhash>;
+    using u8zstring_fast_hash  = basic_zstring_hash<char8_t, char_traits<char8_t>, zstring_wyhash>;
+    using u16zstring_fast_hash = basic_zstring_hash<char16_t, char_traits<char16_t>, zstring_wyhash>;
+    using u32zstring_fast_hash = basic_zstring_hash<char32_t, char_traits<char32_t>, zstring_wyhash>;
+    using wzstring_fast_hash   = basic_zstring_hash<wchar_t, char_traits<wchar_t>, zstring_wyhash>;
+    using zstring_equal      = basic_zstring_equal<char>;
+    using u8zstring_equal    = basic_zstring_equal<char8_t>;
+    using u16zstring_equal   = basic_zstring_equal<char16_t>;
+    using u32zstring_equal   = basic_zstring_equal<char32_t>;
+    using wzstring_equal     = basic_zstring_equal<wchar_t>;
+}
+
+namespace std::__zsv {
+    // Reads the bytes of a string of code units, least significant byte of each code unit first. At run time on
+    // little-endian targets that is the object representation and reads are plain loads.
+    template<class charT>
+    struct __byte_reader {
+        const charT* str;
+
+        constexpr uint64_t byte(size_t offset) const noexcept {
+            return (__unit(str[offset / sizeof(charT)]) >> (8 * (offset % sizeof(charT)))) & 0xff;
+        }
+        template<size_t N>
+        constexpr uint64_t read(size_t offset) const noexcept {
+            if(!is_constant_evaluated() && endian::native == endian::little) {
+                conditional_t<N == 8, uint64_t, uint32_t> value;
+                memcpy(&value, reinterpret_cast<const char*>(str) + offset, N);
+                return value;
+            }
+            uint64_t value = 0;
+            for(size_t i = 0; i < N; i++) {
+                value |= byte(offset + i) << (8 * i);
+            }
+            return value;
+        }
+    };
+
+    #ifdef __SIZEOF_INT128__
+    // __extension__ keeps -Wpedantic quiet about the non-standard type
+    __extension__ using __wyu128 = unsigned __int128;
+    #endif
+
+    constexpr void __wymum(uint64_t& a, uint64_t& b) noexcept {
+        #ifdef __SIZEOF_INT128__
+        const __wyu128 product = static_cast<__wyu128>(a) * b;
+        a = static_cast<uint64_t>(product);
+        b = static_cast<uint64_t>(product >> 64);
+        #else
+        const uint64_t ha = a >> 32, hb = b >> 32, la = uint32_t(a), lb = uint32_t(b);
+        const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        const uint64_t t = rl + (rm0 << 32);
+        uint64_t carry = t < rl;
+        const uint64_t lo = t + (rm1 << 32);
+        carry += lo < t;
+        a = lo;
+        b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+        #endif
+    }
+
+    constexpr uint64_t __wymix(uint64_t a, uint64_t b) noexcept {
+        __wymum(a, b);
+        return a ^ b;
+    }
+
+    // reader provides byte(offset) and read<4>/read<8>(offset) over a sequence of len bytes
+    template<class Reader>
+    constexpr uint64_t __wyhash(const Reader& reader, size_t len, uint64_t seed) noexcept {
+        constexpr uint64_t secret[4] = {0x2d358dccaa6c78a5, 0x8bb84b93962eacc9, 0x4b33a62ed433d4a3, 0x4d5a2da51de1aa47};
+        seed ^= __wymix(seed ^ secret[0], secret[1]);
+        uint64_t a = 0;
+        uint64_t b = 0;
+        if(len <= 16) {
+            if(len >= 4) {
+                const size_t shift = (len >> 3) << 2;
+                a = (reader.template read<4>(0) << 32) | reader.template read<4>(shift);
+                b = (reader.template read<4>(len - 4) << 32) | reader.template read<4>(len - 4 - shift);
+            } else if(len > 0) {
+                a = (reader.byte(0) << 16) | (reader.byte(len >> 1) << 8) | reader.byte(len - 1);
+            }
+        } else {
+            size_t offset = 0;
+            size_t remaining = len;
+            if(remaining > 48) {
+                uint64_t see1 = seed;
+                uint64_t see2 = seed;
+                do {
+                    seed = __wymix(reader.template read<8>(offset) ^ secret[1], reader.template read<8>(offset + 8) ^ seed);
+                    see1 = __wymix(reader.template read<8>(offset + 16) ^ secret[2], reader.template read<8>(offset + 24) ^ see1);
+                    see2 = __wymix(reader.template read<8>(offset + 32) ^ secret[3], reader.template read<8>(offset + 40) ^ see2);
+                    offset += 48;
+                    remaining -= 48;
+                } while(remaining > 48);
+                seed ^= see1 ^ see2;
+            }
+            while(remaining > 16) {
+                seed = __wymix(reader.template read<8>(offset) ^ secret[1], reader.template read<8>(offset + 8) ^ seed);
+                offset += 16;
+                remaining -= 16;
+            }
+            a = reader.template read<8>(offset + remaining - 16);
+            b = reader.template read<8>(offset + remaining - 8);
+        }
+        a ^= secret[1];
+        b ^= seed;
+        __wymum(a, b);
+        return __wymix(a ^ secret[0] ^ len, b ^ secret[1]);
+    }
+}
+
+namespace std {
+    struct zstring_wyhash {
+        template<class charT, class traits>
+        static constexpr uint64_t hash(basic_string_view<charT, traits> str, uint64_t seed = 0) noexcept {
+            return __zsv::__wyhash(__zsv::__byte_reader<charT>{str.data()}, str.size() * sizeof(charT), seed);
+        }
+        template<class charT, class traits>
+        constexpr size_t operator()(basic_string_view<charT, traits> str) const noexcept {
+            return static_cast<size_t>(hash(str));
+        }
+    };
+
+    template<class charT, class traits, class Hash>
+    struct basic_zstring_hash {
+        using is_transparent = void;
+
+        template<class T>
+            requires is_convertible_v<const T&, basic_string_view<charT, traits>>
+        constexpr size_t operator()(const T& str) const
+            noexcept(noexcept(Hash{}(declval<basic_string_view<charT, traits>>()))) {
+            return Hash{}(basic_string_view<charT, traits>(str));
+        }
+    };
+
+    #ifdef __GLIBCXX__
+    // Hashing a string isn't cheap, so have libstdc++'s unordered containers cache hash codes in their nodes as they
+    // do for std::hash<basic_string>, rather than rehash nodes while walking a bucket
+    template<class charT, class traits, class Hash>
+    struct __is_fast_hash<basic_zstring_hash<charT, traits, Hash>> : false_type {};
+    #endif
+
+    template<class charT, class traits>
+    struct basic_zstring_equal {
+        using is_transparent = void;
+
+        template<class T, class U>
+            requires is_convertible_v<const T&, basic_string_view<charT, traits>>
+                && is_convertible_v<const U&, basic_string_view<charT, traits>>
+        constexpr bool operator()(const T& x, const U& y) const noexcept {
+            return basic_string_view<charT, traits>(x) == basic_string_view<charT, traits>(y);
+        }
+    };
+}
+
+#endif
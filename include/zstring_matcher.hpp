@@ -0,0 +1,341 @@
+#ifndef ZSTRING_MATCHER_HPP
+#define ZSTRING_MATCHER_HPP
+
+#include "zstring_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// NOTE: Not part of proposal. basic_zstring_matcher compiles a set of patterns into an Aho-Corasick automaton and
+// answers questions about all of them in one pass over a haystack, instead of one starts_with or contains per pattern:
+//
+//     const std::zstring_matcher routes{"/api/", "/api/v2/", "/static/", "/"};
+//     if(auto route = routes.longest_prefix(path)) { handlers[route->pattern](path); }
+//
+//     const std::zstring_matcher alerts{"ERROR", "FATAL", "panic:"};
+//     if(alerts.contains_any(line)) { ... }
+//
+// The automaton is a complete DFA in one flat array of uint32_t: bytes are first mapped to classes (one per distinct
+// byte in the patterns, one for all other bytes and one for the terminator), and each state is a row of class_count()
+// transitions. States are numbered by their row offset, so a step is table[state + class]. The terminator moves every
+// state to the stop state 0, and states with matches come right after it, so the scan loop is two loads and one
+// comparison per byte and never looks at a length. A haystack with embedded nulls is matched up to the first one,
+// and patterns can't contain nulls.
+//
+// Only code units of one byte are supported: the class table has an entry per byte value.
+
+namespace std {
+    // An occurrence of patterns[pattern] at haystack[position, position + size)
+    struct zstring_match {
+        size_t pattern;
+        size_t position;
+        size_t size;
+
+        friend constexpr bool operator==(const zstring_match&, const zstring_match&) noexcept = default;
+    };
+
+    template<class charT>
+    class basic_zstring_matcher {
+        static_assert(sizeof(charT) == 1, "basic_zstring_matcher matches code units of one byte");
+
+    public:
+        // types
+        using value_type       = charT;
+        using size_type        = size_t;
+        using state_type       = uint32_t;
+        using string_view_type = basic_string_view<charT>;
+        using zstring_view_type = basic_zstring_view<charT>;
+
+        basic_zstring_matcher(initializer_list<zstring_view_type> patterns) {
+            build(patterns);
+        }
+        template<ranges::input_range R>
+            requires convertible_to<ranges::range_reference_t<R>, string_view_type>
+        explicit basic_zstring_matcher(R&& patterns) {
+            build(patterns);
+        }
+
+        // The longest pattern that haystack starts with, or nullopt. Reads at most max_pattern_size() code units.
+        constexpr optional<zstring_match> longest_prefix(const charT* haystack) const noexcept {
+            optional<zstring_match> match;
+            state_type state = root_;
+            // The root only matches with an empty pattern
+            if(state <= last_match_state_) {
+                match = zstring_match{prefix_pattern_[state / class_count_], 0, 0};
+            }
+            for(size_type i = 0; i < max_pattern_size_; i++) {
+                state = step(state, haystack[i]);
+                if(state <= last_match_state_) {
+                    if(state == 0) {
+                        break;
+                    }
+                    // Only the pattern spelled by the path to this state can be a prefix. Once the automaton has
+                    // taken a failure transition no later state is on that path, since depth grows by at most one.
+                    const size_type pattern = prefix_pattern_[state / class_count_];
+                    if(pattern != npos && sizes_[pattern] == i + 1) {
+                        match = zstring_match{pattern, 0, i + 1};
+                    }
+                }
+            }
+            return match;
+        }
+        constexpr optional<zstring_match> longest_prefix(zstring_view_type haystack) const noexcept {
+            return longest_prefix(haystack.c_str());
+        }
+
+        // Whether any pattern occurs in haystack
+        constexpr bool contains_any(const charT* haystack) const noexcept {
+            state_type state = root_;
+            while(state > last_match_state_) {
+                state = step(state, *haystack++);
+            }
+            return state != 0;
+        }
+        constexpr bool contains_any(zstring_view_type haystack) const noexcept {
+            return contains_any(haystack.c_str());
+        }
+
+        // Calls f(zstring_match) for every occurrence of every pattern, overlapping ones included, in order of where
+        // they end and longest first among those that end at the same place
+        template<class F>
+            requires invocable<F&, const zstring_match&>
+        constexpr void for_each_match(const charT* haystack, F f) const {
+            state_type state = root_;
+            for(size_type i = 0;; i++) {
+                if(state <= last_match_state_) {
+                    if(state == 0) {
+                        return;
+                    }
+                    const size_type row = state / class_count_;
+                    for(size_type j = output_offsets_[row - 1]; j < output_offsets_[row]; j++) {
+                        const size_type pattern = outputs_[j];
+                        f(zstring_match{pattern, i - sizes_[pattern], sizes_[pattern]});
+                    }
+                }
+                state = step(state, haystack[i]);
+            }
+        }
+        template<class F>
+            requires invocable<F&, const zstring_match&>
+        constexpr void for_each_match(zstring_view_type haystack, F f) const {
+            for_each_match(haystack.c_str(), std::move(f));
+        }
+
+        // Every occurrence, in the order for_each_match visits them
+        vector<zstring_match> find_all(const charT* haystack) const {
+            vector<zstring_match> matches;
+            for_each_match(haystack, [&](const zstring_match& match) {
+                matches.push_back(match);
+            });
+            return matches;
+        }
+        vector<zstring_match> find_all(zstring_view_type haystack) const {
+            return find_all(haystack.c_str());
+        }
+
+        constexpr size_type pattern_count() const noexcept {
+            return sizes_.size();
+        }
+        constexpr size_type pattern_size(size_type pattern) const noexcept {
+            return sizes_[pattern];
+        }
+        constexpr size_type max_pattern_size() const noexcept {
+            return max_pattern_size_;
+        }
+
+        // The automaton. The state reached from state on code unit c is transitions()[state + byte_classes()[c]].
+        constexpr size_type state_count() const noexcept {
+            return transitions_.size() / class_count_;
+        }
+        constexpr size_type class_count() const noexcept {
+            return class_count_;
+        }
+        constexpr state_type root_state() const noexcept {
+            return root_;
+        }
+        constexpr span<const state_type> transitions() const noexcept {
+            return transitions_;
+        }
+        constexpr const array<uint8_t, 256>& byte_classes() const noexcept {
+            return classes_;
+        }
+        // States above 0, the stop state, and up to this one have matches
+        constexpr state_type last_match_state() const noexcept {
+            return last_match_state_;
+        }
+
+    private:
+        static constexpr size_type npos = numeric_limits<size_type>::max();
+
+        constexpr state_type step(state_type state, charT c) const noexcept {
+            return transitions_[state + classes_[static_cast<unsigned char>(c)]];
+        }
+
+        template<class R>
+        void build(R&& patterns) {
+            vector<string_view_type> strings;
+            for(auto&& pattern : patterns) {
+                const string_view_type str = pattern;
+                if(str.find(charT()) != string_view_type::npos) {
+                    throw invalid_argument("basic_zstring_matcher: patterns can't contain null characters");
+                }
+                strings.push_back(str);
+                sizes_.push_back(str.size());
+                max_pattern_size_ = std::max(max_pattern_size_, str.size());
+            }
+
+            // Class 0 is the terminator, then one class per byte that occurs in a pattern, then one for the rest
+            array<bool, 256> used{};
+            for(const auto& str : strings) {
+                for(charT c : str) {
+                    used[static_cast<unsigned char>(c)] = true;
+                }
+            }
+            class_count_ = 1;
+            for(size_type byte = 1; byte < 256; byte++) {
+                if(used[byte]) {
+                    classes_[byte] = static_cast<uint8_t>(class_count_++);
+                }
+            }
+            if(class_count_ < 256) {
+                const auto other = static_cast<uint8_t>(class_count_++);
+                for(size_type byte = 1; byte < 256; byte++) {
+                    if(!used[byte]) {
+                        classes_[byte] = other;
+                    }
+                }
+            }
+            const size_type classes = class_count_;
+
+            // Trie, with node 0 the root. 0 is also "no child" since nothing leads back to the root.
+            vector<uint32_t> next(classes, 0);
+            vector<size_type> own{npos}; // the pattern spelled by the path to each node
+            for(size_type pattern = 0; pattern < strings.size(); pattern++) {
+                size_type node = 0;
+                for(charT c : strings[pattern]) {
+                    const size_type edge = node * classes + classes_[static_cast<unsigned char>(c)];
+                    if(next[edge] == 0) {
+                        if(own.size() > numeric_limits<uint32_t>::max() / classes - 1) {
+                            throw length_error("basic_zstring_matcher: too many states");
+                        }
+                        next[edge] = static_cast<uint32_t>(own.size());
+                        next.resize(next.size() + classes, 0);
+                        own.push_back(npos);
+                    }
+                    node = next[edge];
+                }
+                // With duplicate patterns the first one is reported
+                if(own[node] == npos) {
+                    own[node] = pattern;
+                }
+            }
+            const size_type nodes = own.size();
+
+            // Failure links in breadth-first order, filling in the missing transitions from the failure state's.
+            // Node 0 of the DFA is the stop state, so trie node u becomes DFA node u + 1 here.
+            vector<uint32_t> fail(nodes, 0);
+            vector<uint32_t> order{0};
+            vector<uint32_t> dfa((nodes + 1) * classes, 0);
+            for(size_type head = 0; head < order.size(); head++) {
+                const uint32_t node = order[head];
+                for(size_type c = 1; c < classes; c++) {
+                    const uint32_t child = next[node * classes + c];
+                    const uint32_t fallback = node == 0 ? 0 : dfa[(fail[node] + 1) * classes + c] - 1;
+                    if(child != 0) {
+                        fail[child] = node == 0 ? 0 : fallback;
+                        order.push_back(child);
+                        dfa[(node + 1) * classes + c] = child + 1;
+                    } else {
+                        dfa[(node + 1) * classes + c] = fallback + 1;
+                    }
+                }
+            }
+
+            // Outputs: a node's own pattern, then those of its failure node, so longest first
+            vector<vector<uint32_t>> outputs(nodes);
+            for(const uint32_t node : order) {
+                if(own[node] != npos) {
+                    outputs[node].push_back(static_cast<uint32_t>(own[node]));
+                }
+                if(node != 0) {
+                    const auto& inherited = outputs[fail[node]];
+                    outputs[node].insert(outputs[node].end(), inherited.begin(), inherited.end());
+                }
+            }
+
+            // Renumber: stop state, then states with outputs, then the rest, each in breadth-first order
+            vector<uint32_t> row(nodes + 1, 0);
+            uint32_t rows = 1;
+            for(const uint32_t node : order) {
+                if(!outputs[node].empty()) {
+                    row[node + 1] = rows++;
+                }
+            }
+            const uint32_t match_rows = rows;
+            for(const uint32_t node : order) {
+                if(outputs[node].empty()) {
+                    row[node + 1] = rows++;
+                }
+            }
+
+            transitions_.assign((nodes + 1) * classes, 0);
+            prefix_pattern_.assign(nodes + 1, npos);
+            output_offsets_.assign(match_rows, 0);
+            for(const uint32_t node : order) {
+                const size_type r = row[node + 1];
+                for(size_type c = 1; c < classes; c++) {
+                    transitions_[r * classes + c] = static_cast<state_type>(row[dfa[(node + 1) * classes + c]] * classes);
+                }
+                prefix_pattern_[r] = own[node];
+            }
+            for(const uint32_t node : order) {
+                if(const size_type r = row[node + 1]; r < match_rows) {
+                    output_offsets_[r] = outputs[node].size();
+                }
+            }
+            // output_offsets_[r - 1] to output_offsets_[r] are the outputs of match row r
+            size_type total = 0;
+            for(size_type r = 1; r < match_rows; r++) {
+                total += output_offsets_[r];
+                output_offsets_[r] = total;
+            }
+            outputs_.resize(total);
+            for(const uint32_t node : order) {
+                if(const size_type r = row[node + 1]; r < match_rows) {
+                    std::copy(outputs[node].begin(), outputs[node].end(), outputs_.begin() + output_offsets_[r - 1]);
+                }
+            }
+
+            root_ = static_cast<state_type>(row[1] * classes);
+            last_match_state_ = static_cast<state_type>((match_rows - 1) * classes);
+        }
+
+        array<uint8_t, 256> classes_{};
+        size_type class_count_ = 0;
+        vector<state_type> transitions_;
+        state_type root_ = 0;
+        state_type last_match_state_ = 0;
+        vector<size_type> prefix_pattern_; // per row
+        vector<size_type> output_offsets_; // per match row, end offsets into outputs_
+        vector<uint32_t> outputs_;
+        vector<size_type> sizes_;
+        size_type max_pattern_size_ = 0;
+    };
+
+    // basic_zstring_matcher typedef-names
+    using zstring_matcher   = basic_zstring_matcher<char>;
+    using u8zstring_matcher = basic_zstring_matcher<char8_t>;
+}
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef ZSTRING_PERFECT_MAP_HPP
+#define ZSTRING_PERFECT_MAP_HPP
+
+#include "zstring_view.hpp"
+#include "zstring_hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// NOTE: Not part of proposal. zstring_perfect_map is an immutable map over a fixed set of string keys, built in a
+// constant expression with hash-and-displace perfect hashing:
+//
+//     constexpr auto methods = std::make_zstring_perfect_map<int>({{"GET"zsv, 1}, {"POST"zsv, 2}, {"PUT"zsv, 3}});
+//     methods.find(request_method); // const int* or nullptr
+//
+// Keys are hashed once with zstring_wyhash into buckets; every bucket gets a displacement, found at build time, that
+// sends its keys to distinct slots. A lookup is one string hash, one mix with the bucket's displacement and one
+// string comparison. Empty slots refer to the first key, so there is no separate emptiness check.
+//
+// Keys that compare equal must hash equal, so with traits other than char_traits<charT> the hash is
+// std::hash<basic_string_view<charT, traits>> instead, and the map can be built at compile time if that hash is
+// constexpr, as ci_char_traits' is.
+
+namespace std {
+    template<class T, size_t N, class charT = char, class traits = char_traits<charT>>
+    class zstring_perfect_map;
+
+    template<class T, class charT = char, class traits = char_traits<charT>, size_t N>
+    constexpr zstring_perfect_map<T, N, charT, traits> make_zstring_perfect_map(
+        const pair<basic_zstring_view<charT, traits>, T> (&entries)[N]
+    );
+
+    template<class T, size_t N, class charT, class traits>
+    class zstring_perfect_map {
+        static_assert(N > 0, "zstring_perfect_map needs at least one key");
+        static_assert(
+            __zsv::__is_default_traits<charT, traits> || is_default_constructible_v<std::hash<basic_string_view<charT, traits>>>,
+            "zstring_perfect_map needs a hash consistent with traits"
+        );
+
+    public:
+        // types
+        using key_type         = basic_zstring_view<charT, traits>;
+        using mapped_type      = T;
+        using size_type        = size_t;
+        using string_view_type = basic_string_view<charT, traits>;
+
+        static constexpr size_type slot_count = bit_ceil(N + N / 4 + 1);
+        static constexpr size_type bucket_count = bit_ceil(N / 4 + 1);
+
+        // The value for key, or nullptr if it isn't one of the keys
+        template<class K>
+            requires is_convertible_v<const K&, string_view_type>
+        constexpr const T* find(const K& key) const noexcept {
+            const string_view_type str = key;
+            const uint64_t hash = key_hash(str);
+            const size_type index = slots_[slot(hash, displacements_[hash & (bucket_count - 1)])];
+            return string_view_type(keys_[index]) == str ? &values_[index] : nullptr;
+        }
+        template<class K>
+            requires is_convertible_v<const K&, string_view_type>
+        constexpr bool contains(const K& key) const noexcept {
+            return find(key) != nullptr;
+        }
+        template<class K>
+            requires is_convertible_v<const K&, string_view_type>
+        constexpr const T& at(const K& key) const {
+            if(const T* value = find(key)) {
+                return *value;
+            }
+            throw std::out_of_range("zstring_perfect_map::at: key not found");
+        }
+
+        constexpr size_type size() const noexcept {
+            return N;
+        }
+        // The keys and values in the order they were given
+        constexpr const array<key_type, N>& keys() const noexcept {
+            return keys_;
+        }
+        constexpr const array<T, N>& values() const noexcept {
+            return values_;
+        }
+
+    private:
+        using index_type = conditional_t<(N <= 0xffff), uint16_t, uint32_t>;
+
+        template<class U, class C, class Tr, size_t M>
+        friend constexpr zstring_perfect_map<U, M, C, Tr> make_zstring_perfect_map(
+            const pair<basic_zstring_view<C, Tr>, U> (&entries)[M]
+        );
+
+        static constexpr uint64_t key_hash(string_view_type str) noexcept {
+            if constexpr(__zsv::__is_default_traits<charT, traits>) {
+                return zstring_wyhash::hash(str);
+            } else {
+                return std::hash<string_view_type>{}(str);
+            }
+        }
+
+        static constexpr size_type slot(uint64_t hash, uint32_t displacement) noexcept {
+            return __zsv::__wymix(hash, 0x9e3779b97f4a7c15 * (displacement + 1)) & (slot_count - 1);
+        }
+
+        template<size_t... I>
+        constexpr zstring_perfect_map(const pair<key_type, T> (&entries)[N], index_sequence<I...>)
+            : keys_{entries[I].first...}, values_{entries[I].second...}, slots_(), displacements_() {}
+
+        explicit constexpr zstring_perfect_map(const pair<key_type, T> (&entries)[N])
+            : zstring_perfect_map(entries, make_index_sequence<N>()) {
+            array<uint64_t, N> hashes{};
+            for(size_type i = 0; i < N; i++) {
+                hashes[i] = key_hash(keys_[i]);
+            }
+            for(size_type i = 0; i < N; i++) {
+                for(size_type j = i + 1; j < N; j++) {
+                    if(hashes[i] == hashes[j]) {
+                        throw std::invalid_argument(
+                            keys_[i] == keys_[j]
+                                ? "zstring_perfect_map: duplicate key"
+                                : "zstring_perfect_map: keys with colliding hashes"
+                        );
+                    }
+                }
+            }
+            // Place the largest buckets first, while most slots are free
+            array<size_type, bucket_count> bucket_sizes{};
+            for(size_type i = 0; i < N; i++) {
+                bucket_sizes[hashes[i] & (bucket_count - 1)]++;
+            }
+            array<size_type, bucket_count> order{};
+            for(size_type b = 0; b < bucket_count; b++) {
+                order[b] = b;
+            }
+            std::sort(order.begin(), order.end(), [&](size_type x, size_type y) {
+                return bucket_sizes[x] > bucket_sizes[y];
+            });
+            array<bool, slot_count> occupied{};
+            array<size_type, N> members{};
+            array<size_type, N> member_slots{};
+            for(size_type bucket : order) {
+                size_type count = 0;
+                for(size_type i = 0; i < N; i++) {
+                    if((hashes[i] & (bucket_count - 1)) == bucket) {
+                        members[count++] = i;
+                    }
+                }
+                if(count == 0) {
+                    break;
+                }
+                uint32_t displacement = 0;
+                while(true) {
+                    bool placed = true;
+                    for(size_type m = 0; m < count && placed; m++) {
+                        member_slots[m] = slot(hashes[members[m]], displacement);
+                        placed = !occupied[member_slots[m]];
+                        for(size_type k = 0; k < m && placed; k++) {
+                            placed = member_slots[k] != member_slots[m];
+                        }
+                    }
+                    if(placed) {
+                        break;
+                    }
+                    if(++displacement == (uint32_t(1) << 20)) {
+                        throw std::invalid_argument("zstring_perfect_map: no perfect hash found");
+                    }
+                }
+                displacements_[bucket] = displacement;
+                for(size_type m = 0; m < count; m++) {
+                    occupied[member_slots[m]] = true;
+                    slots_[member_slots[m]] = static_cast<index_type>(members[m]);
+                }
+            }
+        }
+
+        array<key_type, N> keys_;
+        array<T, N> values_;
+        array<index_type, slot_count> slots_; // index of the key in each slot, 0 for empty slots
+        array<uint32_t, bucket_count> displacements_;
+    };
+
+    template<class T, class charT, class traits, size_t N>
+    constexpr zstring_perfect_map<T, N, charT, traits> make_zstring_perfect_map(
+        const pair<basic_zstring_view<charT, traits>, T> (&entries)[N]
+    ) {
+        return zstring_perfect_map<T, N, charT, traits>(entries);
+    }
+}
+
+#endif
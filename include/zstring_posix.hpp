@@ -0,0 +1,139 @@
+#ifndef ZSTRING_POSIX_HPP
+#define ZSTRING_POSIX_HPP
+
+#include "zstring_view.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <span>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+// NOTE: Not part of proposal. POSIX only. Thin wrappers that pass zstring_views straight to the C API, without the
+// copy a string_view would need. They keep the C functions' return values and errno conventions.
+//
+// zstring_view_array packs a sequence of zstring_views into the null-pointer-terminated array of pointers that argv and
+// envp are, without copying the strings.
+//
+// The wrappers live in zstring_posix rather than std because their names are those of the C functions: std::open or
+// std::stat would clash with ::open and ::stat wherever both are visible.
+
+namespace zstring_posix {
+    class zstring_view_array {
+    public:
+        using size_type = std::size_t;
+
+        // Strings that fit without allocating
+        static constexpr size_type inline_capacity = 16;
+
+        zstring_view_array(std::span<const std::zstring_view> strings) : size_(strings.size()) {
+            pointers_ = inline_;
+            if(strings.size() > inline_capacity) {
+                heap_ = std::make_unique_for_overwrite<char*[]>(strings.size() + 1);
+                pointers_ = heap_.get();
+            }
+            for(size_type i = 0; i < strings.size(); i++) {
+                // The exec family takes char* const[] for historical reasons but doesn't modify the strings
+                pointers_[i] = const_cast<char*>(strings[i].c_str());
+            }
+            pointers_[strings.size()] = nullptr;
+        }
+        zstring_view_array(std::initializer_list<std::zstring_view> strings)
+            : zstring_view_array(std::span<const std::zstring_view>(strings.begin(), strings.size())) {}
+        // Points into the array itself, so it can be neither copied nor moved
+        zstring_view_array(const zstring_view_array&) = delete;
+        zstring_view_array& operator=(const zstring_view_array&) = delete;
+
+        // The null-pointer-terminated array
+        char* const* data() const noexcept {
+            return pointers_;
+        }
+        size_type size() const noexcept {
+            return size_;
+        }
+        [[nodiscard]] bool empty() const noexcept {
+            return size_ == 0;
+        }
+        std::zstring_view operator[](size_type i) const noexcept {
+            return std::zstring_view(pointers_[i]);
+        }
+
+    private:
+        char** pointers_;
+        size_type size_;
+        std::unique_ptr<char*[]> heap_;
+        char* inline_[inline_capacity + 1];
+    };
+
+    // files
+    inline int open(std::zstring_view path, int flags, mode_t mode = 0) {
+        return ::open(path.c_str(), flags, mode);
+    }
+    inline int openat(int dirfd, std::zstring_view path, int flags, mode_t mode = 0) {
+        return ::openat(dirfd, path.c_str(), flags, mode);
+    }
+    inline int stat(std::zstring_view path, struct stat* buf) {
+        return ::stat(path.c_str(), buf);
+    }
+    inline int access(std::zstring_view path, int mode) {
+        return ::access(path.c_str(), mode);
+    }
+    inline int unlink(std::zstring_view path) {
+        return ::unlink(path.c_str());
+    }
+
+    // environment
+    // The value of the variable, if it is set. The view is invalidated by later changes to the variable.
+    inline std::optional<std::zstring_view> getenv(std::zstring_view name) {
+        if(const char* value = ::getenv(name.c_str())) {
+            return std::zstring_view(value);
+        }
+        return std::nullopt;
+    }
+    inline int setenv(std::zstring_view name, std::zstring_view value, bool overwrite = true) {
+        return ::setenv(name.c_str(), value.c_str(), overwrite);
+    }
+
+    // dynamic loading
+    inline void* dlopen(std::zstring_view path, int flags) {
+        return ::dlopen(path.c_str(), flags);
+    }
+
+    // processes, envp can also be a raw array such as environ
+    inline int execve(std::zstring_view path, const zstring_view_array& argv, char* const envp[]) {
+        return ::execve(path.c_str(), argv.data(), envp);
+    }
+    inline int execve(std::zstring_view path, const zstring_view_array& argv, const zstring_view_array& envp) {
+        return execve(path, argv, envp.data());
+    }
+    inline int posix_spawn(
+        pid_t* pid,
+        std::zstring_view path,
+        const posix_spawn_file_actions_t* file_actions,
+        const posix_spawnattr_t* attr,
+        const zstring_view_array& argv,
+        char* const envp[]
+    ) {
+        return ::posix_spawn(pid, path.c_str(), file_actions, attr, argv.data(), envp);
+    }
+    inline int posix_spawn(
+        pid_t* pid,
+        std::zstring_view path,
+        const posix_spawn_file_actions_t* file_actions,
+        const posix_spawnattr_t* attr,
+        const zstring_view_array& argv,
+        const zstring_view_array& envp
+    ) {
+        return posix_spawn(pid, path, file_actions, attr, argv, envp.data());
+    }
+}
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef ZSTRING_SPLIT_HPP
+#define ZSTRING_SPLIT_HPP
+
+#include "zstring_view.hpp"
+
+#include <cassert>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string>
+#include <type_traits>
+
+// NOTE: Not part of proposal. Range adaptors that produce basic_zstring_views from delimited text without copying:
+//
+//     views::zsplit(buffer, ',')   splits a mutable buffer in place, overwriting each delimiter with charT() as the
+//                                  iteration reaches it (like strtok, but reentrant and lazy). buffer | views::zsplit(',')
+//                                  works too.
+//     views::zsplit_nul(block)     iterates an already NUL-separated block, e.g. the output of find -print0 or
+//                                  /proc/<pid>/environ, without modifying it. A const charT* block ends at an empty
+//                                  element (double-NUL terminated, like a Windows environment block).
+
+namespace std::ranges {
+    // Splits buffer on delim. buffer.data()[buffer.size()] must be charT(), as for basic_zstring_view. Empty tokens
+    // between adjacent delimiters are produced, a trailing delimiter doesn't start another token. This is an input
+    // range: the buffer is modified as it is iterated, so it can be iterated once.
+    template<class charT, class traits = char_traits<charT>>
+    class zsplit_view : public view_interface<zsplit_view<charT, traits>> {
+    public:
+        constexpr zsplit_view(span<charT> buffer, charT delim) noexcept
+            : next_(buffer.data()), end_(buffer.data() + buffer.size()), delim_(delim) {
+            assert(traits::eq(*end_, charT()));
+        }
+
+        constexpr auto begin() {
+            advance();
+            return iterator(*this);
+        }
+        constexpr default_sentinel_t end() const noexcept {
+            return default_sentinel;
+        }
+
+    private:
+        class iterator {
+        public:
+            using iterator_concept = input_iterator_tag;
+            using value_type       = basic_zstring_view<charT, traits>;
+            using difference_type  = ptrdiff_t;
+
+            iterator(const iterator&) = delete;
+            iterator(iterator&&) = default;
+            iterator& operator=(const iterator&) = delete;
+            iterator& operator=(iterator&&) = default;
+
+            constexpr value_type operator*() const noexcept {
+                return parent_->token_;
+            }
+            constexpr iterator& operator++() {
+                parent_->advance();
+                return *this;
+            }
+            constexpr void operator++(int) {
+                ++*this;
+            }
+            friend constexpr bool operator==(const iterator& it, default_sentinel_t) noexcept {
+                return it.done();
+            }
+
+        private:
+            friend zsplit_view;
+            constexpr explicit iterator(zsplit_view& parent) noexcept : parent_(&parent) {}
+            constexpr bool done() const noexcept {
+                return parent_->next_ == nullptr;
+            }
+            zsplit_view* parent_;
+        };
+
+        // Finds the next token and terminates it; next_ becomes null once the tokens are exhausted
+        constexpr void advance() {
+            if(next_ == nullptr || next_ == end_) {
+                next_ = nullptr;
+                return;
+            }
+            const basic_zstring_view<charT, traits> rest(next_, end_ - next_);
+            const size_t pos = rest.find(delim_);
+            if(pos == rest.npos) {
+                token_ = rest;
+                next_ = end_;
+            } else {
+                traits::assign(next_[pos], charT());
+                token_ = basic_zstring_view<charT, traits>(next_, pos);
+                next_ += pos + 1;
+            }
+        }
+
+        charT* next_;
+        charT* end_;
+        charT delim_;
+        basic_zstring_view<charT, traits> token_;
+    };
+
+    // The NUL-terminated elements of a block. Constructed from a basic_string_view every element, including the last,
+    // must be terminated within the block and empty elements are produced. Constructed from a pointer the block ends
+    // at the first empty element.
+    template<class charT, class traits = char_traits<charT>>
+    class zsplit_nul_view : public view_interface<zsplit_nul_view<charT, traits>> {
+    public:
+        constexpr zsplit_nul_view() noexcept = default;
+        constexpr explicit zsplit_nul_view(basic_string_view<charT, traits> block) noexcept
+            : begin_(block.data()), end_(block.data() + block.size()) {
+            assert(block.empty() || traits::eq(block.back(), charT()));
+        }
+        constexpr explicit zsplit_nul_view(const charT* block) noexcept : begin_(block), end_(nullptr) {}
+
+        class iterator {
+        public:
+            using iterator_concept  = forward_iterator_tag;
+            using iterator_category = forward_iterator_tag;
+            using value_type        = basic_zstring_view<charT, traits>;
+            using difference_type   = ptrdiff_t;
+
+            constexpr iterator() noexcept = default;
+
+            constexpr value_type operator*() const noexcept {
+                return value_type(current_, size_);
+            }
+            constexpr iterator& operator++() noexcept {
+                current_ += size_ + 1;
+                measure();
+                return *this;
+            }
+            constexpr iterator operator++(int) noexcept {
+                iterator copy = *this;
+                ++*this;
+                return copy;
+            }
+            friend constexpr bool operator==(const iterator& x, const iterator& y) noexcept {
+                return x.current_ == y.current_;
+            }
+            friend constexpr bool operator==(const iterator& it, default_sentinel_t) noexcept {
+                return it.end_ ? it.current_ == it.end_ : it.size_ == 0;
+            }
+
+        private:
+            friend zsplit_nul_view;
+            constexpr iterator(const charT* current, const charT* end) noexcept : current_(current), end_(end) {
+                measure();
+            }
+            constexpr void measure() noexcept {
+                size_ = current_ == end_ ? 0 : __zsv::__length<charT, traits>(current_);
+            }
+
+            const charT* current_ = nullptr;
+            const charT* end_ = nullptr; // null for double-NUL terminated blocks
+            size_t size_ = 0;
+        };
+
+        constexpr iterator begin() const noexcept {
+            return iterator(begin_, end_);
+        }
+        constexpr default_sentinel_t end() const noexcept {
+            return default_sentinel;
+        }
+
+    private:
+        const charT* begin_ = nullptr;
+        const charT* end_ = nullptr;
+    };
+
+    template<class charT, class traits>
+        constexpr bool enable_borrowed_range<zsplit_nul_view<charT, traits>> = true;
+}
+
+namespace std::__zsv {
+    template<class R>
+    concept __zsplit_buffer = ranges::contiguous_range<R> && ranges::sized_range<R>
+        && (ranges::borrowed_range<R> || is_lvalue_reference_v<R>)
+        && !is_const_v<remove_reference_t<ranges::range_reference_t<R>>>;
+
+    template<class Delim>
+    struct __zsplit_closure {
+        Delim delim;
+
+        template<__zsplit_buffer R>
+        friend constexpr auto operator|(R&& buffer, const __zsplit_closure& closure) {
+            using charT = ranges::range_value_t<R>;
+            return ranges::zsplit_view<charT>(span<charT>(buffer), static_cast<charT>(closure.delim));
+        }
+    };
+
+    struct __zsplit_fn {
+        template<__zsplit_buffer R>
+        constexpr auto operator()(R&& buffer, ranges::range_value_t<R> delim) const {
+            using charT = ranges::range_value_t<R>;
+            return ranges::zsplit_view<charT>(span<charT>(buffer), delim);
+        }
+        template<class Delim>
+        constexpr __zsplit_closure<Delim> operator()(Delim delim) const noexcept {
+            return {delim};
+        }
+    };
+
+    struct __zsplit_nul_fn {
+        template<class charT, class traits>
+        constexpr auto operator()(basic_string_view<charT, traits> block) const noexcept {
+            return ranges::zsplit_nul_view<charT, traits>(block);
+        }
+        template<class charT, class traits, class Allocator>
+        constexpr auto operator()(const basic_string<charT, traits, Allocator>& block) const noexcept {
+            return ranges::zsplit_nul_view<charT, traits>(block);
+        }
+        // The view would outlive a temporary string
+        template<class charT, class traits, class Allocator>
+        void operator()(basic_string<charT, traits, Allocator>&&) const = delete;
+        template<class charT>
+        constexpr auto operator()(const charT* block) const noexcept {
+            return ranges::zsplit_nul_view<charT>(block);
+        }
+    };
+}
+
+namespace std::ranges::views {
+    inline constexpr __zsv::__zsplit_fn zsplit;
+    inline constexpr __zsv::__zsplit_nul_fn zsplit_nul;
+}
+
+#endif
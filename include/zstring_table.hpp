@@ -0,0 +1,415 @@
+#ifndef ZSTRING_TABLE_HPP
+#define ZSTRING_TABLE_HPP
+
+#include "zstring_view.hpp"
+#include "zstring_hash.hpp"
+#include "mapped_zfile.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// NOTE: Not part of proposal. POSIX only. A string table is a read-only blob of null-terminated strings with an index,
+// in the spirit of an ELF .strtab, that can be mapped and used in place:
+//
+//     std::zstring_table_builder builder;
+//     for(const auto& symbol : symbols) { ids.push_back(builder.add(symbol)); }
+//     builder.write("symbols.zst");
+//
+//     const std::zstring_table table("symbols.zst"); // one mmap, no parsing
+//     std::zstring_view name = table[id];
+//     size_t id = table.find("main");
+//
+// Layout, in native byte order (the magic number detects a mismatch):
+//
+//     header   magic, version, code unit size, string count, string area size in code units, slot count, checksum
+//     index    per id: uint32 offset and uint32 size in code units into the string area
+//     slots    a linear probing hash table for find: per slot the low 32 bits of the string's zstring_wyhash and
+//              its id plus one, or 0 for an empty slot
+//     strings  the strings, each followed by a terminator
+//
+// A lookup hashes the string, maps the high 32 bits of the hash onto the slots and compares strings only where the
+// stored low bits match, so it usually reads one slot and one string.
+//
+// The builder shares tails: a string that ends another one, such as "size" and "resize", points into it instead of
+// being stored again. Opening a table only checks the header and that the sizes add up to the size of the blob, so the
+// cost doesn't depend on the number of strings. Lookups are bounded by the slot count and ignore slots with ids out of
+// range, but operator[] trusts the index, so a table from an untrusted source must pass validate(), which checks every
+// index entry and slot, before strings are read from it. The checksum, a wyhash of everything after the header that
+// verify_checksum() computes, only detects accidental corruption: anyone who can modify the table can recompute it.
+
+namespace std {
+    template<class charT>
+    class basic_zstring_table_builder;
+    template<class charT>
+    class basic_zstring_table;
+
+    // typedef-names
+    using zstring_table_builder    = basic_zstring_table_builder<char>;
+    using u8zstring_table_builder  = basic_zstring_table_builder<char8_t>;
+    using u16zstring_table_builder = basic_zstring_table_builder<char16_t>;
+    using u32zstring_table_builder = basic_zstring_table_builder<char32_t>;
+    using wzstring_table_builder   = basic_zstring_table_builder<wchar_t>;
+    using zstring_table    = basic_zstring_table<char>;
+    using u8zstring_table  = basic_zstring_table<char8_t>;
+    using u16zstring_table = basic_zstring_table<char16_t>;
+    using u32zstring_table = basic_zstring_table<char32_t>;
+    using wzstring_table   = basic_zstring_table<wchar_t>;
+}
+
+namespace std::__zsv {
+    inline constexpr uint32_t __table_magic = 0x42545a5a; // "ZZTB" in little-endian order
+    inline constexpr uint16_t __table_version = 1;
+
+    struct __table_header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t unit_size;
+        uint32_t count;
+        uint32_t string_units;
+        uint32_t slot_count;
+        uint32_t reserved;
+        uint64_t checksum;
+    };
+    static_assert(sizeof(__table_header) == 32);
+
+    struct __table_entry {
+        uint32_t offset;
+        uint32_t size;
+    };
+    static_assert(sizeof(__table_entry) == 8);
+
+    struct __table_slot {
+        uint32_t hash;
+        uint32_t id; // plus one, 0 if empty
+    };
+    static_assert(sizeof(__table_slot) == 8);
+
+    // Load factor of at most 2/3
+    constexpr uint64_t __table_slot_count(uint64_t count) noexcept {
+        return count + count / 2 + 1;
+    }
+
+    // Size in bytes of a table with count strings, slots slots and units code units of string area
+    constexpr uint64_t __table_size(uint64_t count, uint64_t slots, uint64_t units, uint64_t unit_size) noexcept {
+        return sizeof(__table_header) + count * sizeof(__table_entry) + slots * sizeof(__table_slot)
+            + units * unit_size;
+    }
+
+    // The first slot to probe for a hash
+    constexpr uint64_t __table_home_slot(uint64_t hash, uint64_t slots) noexcept {
+        return ((hash >> 32) * slots) >> 32;
+    }
+    constexpr uint64_t __table_next_slot(uint64_t slot, uint64_t slots) noexcept {
+        return slot + 1 == slots ? 0 : slot + 1;
+    }
+
+    inline uint64_t __table_checksum(span<const byte> blob) noexcept {
+        const span<const byte> body = blob.subspan(sizeof(__table_header));
+        return zstring_wyhash::hash(string_view(reinterpret_cast<const char*>(body.data()), body.size()));
+    }
+
+    // Reads a T from a blob, which need not hold T objects
+    template<class T>
+    T __table_load(const byte* p) noexcept {
+        T value;
+        memcpy(&value, p, sizeof(T));
+        return value;
+    }
+}
+
+namespace std {
+    template<class charT>
+    class basic_zstring_table_builder {
+    public:
+        // types
+        using value_type       = charT;
+        using size_type        = size_t;
+        using string_view_type = basic_string_view<charT>;
+
+        // Adds str and returns its id. Ids count up from 0; adding the same string twice gives two ids that share
+        // storage.
+        size_type add(string_view_type str) {
+            // Ids plus one and the slot count must fit in 32 bits
+            if(__zsv::__table_slot_count(strings_.size() + 1) > numeric_limits<uint32_t>::max()) {
+                throw length_error("basic_zstring_table_builder: too many strings");
+            }
+            strings_.emplace_back(str);
+            return strings_.size() - 1;
+        }
+
+        size_type size() const noexcept {
+            return strings_.size();
+        }
+        [[nodiscard]] bool empty() const noexcept {
+            return strings_.empty();
+        }
+
+        // The table as bytes
+        vector<byte> build() const {
+            const size_type count = strings_.size();
+            vector<uint32_t> ids(count);
+            iota(ids.begin(), ids.end(), 0);
+
+            // Ordered by reversed string, any string that ends another ends the one right after it in this order.
+            // Placing strings from last to first, each is either stored or points into the tail of its successor.
+            auto by_tail = ids;
+            std::stable_sort(by_tail.begin(), by_tail.end(), [&](uint32_t x, uint32_t y) {
+                return std::lexicographical_compare(
+                    strings_[x].rbegin(), strings_[x].rend(), strings_[y].rbegin(), strings_[y].rend()
+                );
+            });
+            vector<__zsv::__table_entry> index(count);
+            uint64_t units = 0;
+            for(size_type i = count; i-- > 0;) {
+                const basic_string<charT>& str = strings_[by_tail[i]];
+                if(i + 1 < count && strings_[by_tail[i + 1]].ends_with(str)) {
+                    const __zsv::__table_entry& successor = index[by_tail[i + 1]];
+                    index[by_tail[i]] = {
+                        static_cast<uint32_t>(successor.offset + successor.size - str.size()),
+                        static_cast<uint32_t>(str.size())
+                    };
+                } else {
+                    if(units + str.size() + 1 > numeric_limits<uint32_t>::max()) {
+                        throw length_error("basic_zstring_table_builder: strings too long");
+                    }
+                    index[by_tail[i]] = {static_cast<uint32_t>(units), static_cast<uint32_t>(str.size())};
+                    units += str.size() + 1;
+                }
+            }
+
+            // Only the first of equal strings goes in the hash table, so find returns the smallest id
+            const uint64_t slot_count = __zsv::__table_slot_count(count);
+            vector<__zsv::__table_slot> slots(slot_count);
+            for(uint32_t id = 0; id < count; id++) {
+                const uint64_t hash = zstring_wyhash::hash(string_view_type(strings_[id]));
+                uint64_t slot = __zsv::__table_home_slot(hash, slot_count);
+                for(; slots[slot].id != 0; slot = __zsv::__table_next_slot(slot, slot_count)) {
+                    const __zsv::__table_slot& entry = slots[slot];
+                    if(entry.hash == static_cast<uint32_t>(hash) && strings_[entry.id - 1] == strings_[id]) {
+                        break;
+                    }
+                }
+                if(slots[slot].id == 0) {
+                    slots[slot] = {static_cast<uint32_t>(hash), id + 1};
+                }
+            }
+
+            vector<byte> blob(__zsv::__table_size(count, slot_count, units, sizeof(charT)));
+            const __zsv::__table_header header{
+                __zsv::__table_magic,
+                __zsv::__table_version,
+                static_cast<uint16_t>(sizeof(charT)),
+                static_cast<uint32_t>(count),
+                static_cast<uint32_t>(units),
+                static_cast<uint32_t>(slot_count),
+                0,
+                0
+            };
+            byte* out = blob.data() + sizeof(header);
+            if(count != 0) {
+                memcpy(out, index.data(), count * sizeof(__zsv::__table_entry));
+                out += count * sizeof(__zsv::__table_entry);
+            }
+            memcpy(out, slots.data(), slot_count * sizeof(__zsv::__table_slot));
+            out += slot_count * sizeof(__zsv::__table_slot);
+            // The blob is zero-initialized, so the terminators are already in place. Strings that share a tail are
+            // copied over identical units.
+            for(size_type id = 0; id < count; id++) {
+                const basic_string<charT>& str = strings_[id];
+                memcpy(out + index[id].offset * sizeof(charT), str.data(), str.size() * sizeof(charT));
+            }
+            memcpy(blob.data(), &header, sizeof(header));
+            const uint64_t checksum = __zsv::__table_checksum(blob);
+            memcpy(blob.data() + offsetof(__zsv::__table_header, checksum), &checksum, sizeof(checksum));
+            return blob;
+        }
+
+        // Writes the table to a file, replacing it
+        void write(zstring_view path) const {
+            const vector<byte> blob = build();
+            FILE* file = fopen(path.c_str(), "wb");
+            if(!file) {
+                throw_errno("fopen");
+            }
+            const bool written = fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+            const int write_error = errno;
+            if(fclose(file) != 0 && written) {
+                throw_errno("fclose");
+            }
+            if(!written) {
+                errno = write_error;
+                throw_errno("fwrite");
+            }
+        }
+
+    private:
+        [[noreturn]] static void throw_errno(const char* what) {
+            throw system_error(errno, system_category(), string("basic_zstring_table_builder: ") + what);
+        }
+
+        vector<basic_string<charT>> strings_;
+    };
+
+    template<class charT>
+    class basic_zstring_table {
+    public:
+        // types
+        using value_type       = charT;
+        using size_type        = size_t;
+        using string_view_type = basic_string_view<charT>;
+        using zstring_view_type = basic_zstring_view<charT>;
+
+        static constexpr size_type npos = size_type(-1);
+
+        // Maps the table in a file, with random access advice since lookups touch scattered pages
+        explicit basic_zstring_table(zstring_view path) : file_(in_place, path, mapped_zfile::access_hint::random) {
+            const zstring_view contents = file_->view();
+            open(as_bytes(span(contents.data(), contents.size())));
+        }
+        // Uses a table in memory, which must outlive this and be aligned for uint32_t and charT
+        explicit basic_zstring_table(span<const byte> blob) {
+            open(blob);
+        }
+
+        // The string with the given id
+        zstring_view_type operator[](size_type id) const noexcept {
+            const auto entry = __zsv::__table_load<__zsv::__table_entry>(index_ + id * sizeof(__zsv::__table_entry));
+            return zstring_view_type(strings_ + entry.offset, entry.size);
+        }
+        zstring_view_type at(size_type id) const {
+            if(id >= count_) {
+                throw out_of_range("basic_zstring_table::at: id out of range");
+            }
+            return (*this)[id];
+        }
+
+        // The smallest id of a string equal to str, or npos. Probes each slot at most once, so it terminates even if
+        // a corrupt table has no empty slot.
+        size_type find(string_view_type str) const noexcept {
+            const uint64_t hash = zstring_wyhash::hash(str);
+            uint64_t slot = __zsv::__table_home_slot(hash, slot_count_);
+            for(size_type probes = 0; probes < slot_count_; probes++) {
+                const byte* p = slots_ + slot * sizeof(__zsv::__table_slot);
+                const auto entry = __zsv::__table_load<__zsv::__table_slot>(p);
+                if(entry.id == 0) {
+                    return npos;
+                }
+                if(entry.hash == static_cast<uint32_t>(hash) && entry.id <= count_
+                   && string_view_type((*this)[entry.id - 1]) == str) {
+                    return entry.id - 1;
+                }
+                slot = __zsv::__table_next_slot(slot, slot_count_);
+            }
+            return npos;
+        }
+        bool contains(string_view_type str) const noexcept {
+            return find(str) != npos;
+        }
+
+        size_type size() const noexcept {
+            return count_;
+        }
+        [[nodiscard]] bool empty() const noexcept {
+            return count_ == 0;
+        }
+        uint16_t version() const noexcept {
+            return __zsv::__table_load<__zsv::__table_header>(blob_.data()).version;
+        }
+        // The whole table
+        span<const byte> data() const noexcept {
+            return blob_;
+        }
+
+        // Whether the contents after the header match the checksum the builder stored. Reads the whole table.
+        bool verify_checksum() const noexcept {
+            return __zsv::__table_checksum(blob_) == __zsv::__table_load<__zsv::__table_header>(blob_.data()).checksum;
+        }
+
+        // Whether every index entry lies within the string area and ends at a terminator, and every slot holds an id
+        // in range, so that reading any string by id or by lookup stays within the table. Reads the index and slots.
+        bool validate() const noexcept {
+            for(size_type id = 0; id < count_; id++) {
+                const auto entry = __zsv::__table_load<__zsv::__table_entry>(index_ + id * sizeof(__zsv::__table_entry));
+                const uint64_t end = uint64_t(entry.offset) + entry.size;
+                if(end >= string_units_ || strings_[end] != charT()) {
+                    return false;
+                }
+            }
+            for(size_type slot = 0; slot < slot_count_; slot++) {
+                const auto entry = __zsv::__table_load<__zsv::__table_slot>(slots_ + slot * sizeof(__zsv::__table_slot));
+                if(entry.id > count_) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        [[noreturn]] static void invalid(const char* what) {
+            throw invalid_argument(string("basic_zstring_table: ") + what);
+        }
+
+        void open(span<const byte> blob) {
+            if(blob.size() < sizeof(__zsv::__table_header)) {
+                invalid("too small for a string table");
+            }
+            if(reinterpret_cast<uintptr_t>(blob.data()) % max(alignof(uint32_t), alignof(charT)) != 0) {
+                invalid("misaligned");
+            }
+            const auto header = __zsv::__table_load<__zsv::__table_header>(blob.data());
+            if(header.magic != __zsv::__table_magic) {
+                invalid(byteswap(header.magic) == __zsv::__table_magic ? "wrong byte order" : "not a string table");
+            }
+            if(header.version != __zsv::__table_version) {
+                invalid("unsupported version");
+            }
+            if(header.unit_size != sizeof(charT)) {
+                invalid("wrong code unit size");
+            }
+            // Lookups rely on an empty slot to stop probing
+            if(header.slot_count <= header.count) {
+                invalid("too few slots");
+            }
+            const uint64_t size
+                = __zsv::__table_size(header.count, header.slot_count, header.string_units, sizeof(charT));
+            if(size != blob.size()) {
+                invalid("size doesn't match the header");
+            }
+            blob_ = blob;
+            count_ = header.count;
+            slot_count_ = header.slot_count;
+            string_units_ = header.string_units;
+            index_ = blob.data() + sizeof(__zsv::__table_header);
+            slots_ = index_ + count_ * sizeof(__zsv::__table_entry);
+            strings_ = reinterpret_cast<const charT*>(slots_ + slot_count_ * sizeof(__zsv::__table_slot));
+            if(header.string_units != 0 && strings_[header.string_units - 1] != charT()) {
+                invalid("string area not terminated");
+            }
+        }
+
+        optional<mapped_zfile> file_;
+        span<const byte> blob_;
+        size_type count_ = 0;
+        size_type slot_count_ = 0;
+        size_type string_units_ = 0;
+        const byte* index_ = nullptr;
+        const byte* slots_ = nullptr;
+        const charT* strings_ = nullptr;
+    };
+}
+
+#endif
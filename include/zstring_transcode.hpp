@@ -0,0 +1,455 @@
+#ifndef ZSTRING_TRANSCODE_HPP
+#define ZSTRING_TRANSCODE_HPP
+
+#include "zstring_view.hpp"
+#include "zstring_arena.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+// NOTE: Not part of proposal. transcode converts between the Unicode encodings of the zstring_view typedefs, validating
+// the input and writing terminated output into a caller buffer or an arena:
+//
+//     wchar_t buffer[MAX_PATH];
+//     auto path = std::transcode<wchar_t>(u8path, buffer);
+//     if(path.ec == std::errc()) {
+//         CreateFileW(path.str.c_str(), ...);
+//     }
+//
+// char and char8_t hold UTF-8, char16_t UTF-16, char32_t UTF-32, and wchar_t UTF-16 or UTF-32 depending on its size.
+// Ill-formed input (overlong or truncated UTF-8 sequences, unpaired surrogates, code points past U+10FFFF) is an
+// errc::illegal_byte_sequence error; nothing is replaced. transcoded_length is a validating pre-pass that computes the
+// exact output size. Runs of ASCII are converted a vector at a time; everything else goes through a scalar decoder.
+
+namespace std {
+    template<class charT>
+    struct transcode_result {
+        basic_zstring_view<charT> str; // the output up to position, terminated
+        size_t position;               // source code units converted; on error, the index of the offending one
+        errc ec;                       // errc(), errc::illegal_byte_sequence or errc::value_too_large
+    };
+
+    struct transcoded_length_result {
+        size_t size;     // code units of output, excluding the terminator, for the source up to position
+        size_t position; // source code units validated; on error, the index of the offending one
+        errc ec;         // errc() or errc::illegal_byte_sequence
+    };
+}
+
+namespace std::__zsv {
+    template<class charT>
+    concept __utf_char = is_same_v<charT, char> || is_same_v<charT, char8_t> || is_same_v<charT, char16_t>
+        || is_same_v<charT, char32_t> || is_same_v<charT, wchar_t>;
+
+    // Code unit size of the encoding, which is what distinguishes UTF-8, UTF-16 and UTF-32
+    template<class charT>
+    inline constexpr size_t __utf_width = sizeof(charT);
+
+    inline constexpr char32_t __invalid_code_point = 0xffffffff;
+
+    // Decodes the code point at src[i] and advances i past it, or returns __invalid_code_point and leaves i unchanged
+    template<class charT>
+    constexpr char32_t __decode(const charT* src, size_t size, size_t& i) noexcept {
+        const uint32_t lead = __unit(src[i]);
+        if constexpr(__utf_width<charT> == 1) {
+            if(lead < 0x80) {
+                i++;
+                return lead;
+            }
+            // Unicode Table 3-7: the allowed range of the second byte excludes overlong forms, surrogates and code
+            // points past U+10FFFF
+            size_t length;
+            uint32_t low = 0x80, high = 0xbf;
+            char32_t c;
+            if(lead < 0xc2) {
+                return __invalid_code_point;
+            } else if(lead < 0xe0) {
+                length = 2;
+                c = lead & 0x1f;
+            } else if(lead < 0xf0) {
+                length = 3;
+                c = lead & 0x0f;
+                low = lead == 0xe0 ? 0xa0 : 0x80;
+                high = lead == 0xed ? 0x9f : 0xbf;
+            } else if(lead < 0xf5) {
+                length = 4;
+                c = lead & 0x07;
+                low = lead == 0xf0 ? 0x90 : 0x80;
+                high = lead == 0xf4 ? 0x8f : 0xbf;
+            } else {
+                return __invalid_code_point;
+            }
+            if(size - i < length) {
+                return __invalid_code_point;
+            }
+            const uint32_t second = __unit(src[i + 1]);
+            if(second < low || second > high) {
+                return __invalid_code_point;
+            }
+            c = c << 6 | (second & 0x3f);
+            for(size_t k = 2; k < length; k++) {
+                const uint32_t next = __unit(src[i + k]);
+                if((next & 0xc0) != 0x80) {
+                    return __invalid_code_point;
+                }
+                c = c << 6 | (next & 0x3f);
+            }
+            i += length;
+            return c;
+        } else if constexpr(__utf_width<charT> == 2) {
+            if(lead < 0xd800 || lead > 0xdfff) {
+                i++;
+                return lead;
+            }
+            if(lead > 0xdbff || size - i < 2) {
+                return __invalid_code_point;
+            }
+            const uint32_t trail = __unit(src[i + 1]);
+            if(trail < 0xdc00 || trail > 0xdfff) {
+                return __invalid_code_point;
+            }
+            i += 2;
+            return 0x10000 + ((lead - 0xd800) << 10 | (trail - 0xdc00));
+        } else {
+            if(lead > 0x10ffff || (lead >= 0xd800 && lead <= 0xdfff)) {
+                return __invalid_code_point;
+            }
+            i++;
+            return lead;
+        }
+    }
+
+    // Code units needed to encode c
+    template<class charT>
+    constexpr size_t __encoded_length(char32_t c) noexcept {
+        if constexpr(__utf_width<charT> == 1) {
+            return c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+        } else if constexpr(__utf_width<charT> == 2) {
+            return c < 0x10000 ? 1 : 2;
+        } else {
+            return 1;
+        }
+    }
+
+    // Writes the __encoded_length<charT>(c) code units of c to dst
+    template<class charT>
+    constexpr void __encode(char32_t c, charT* dst) noexcept {
+        if constexpr(__utf_width<charT> == 1) {
+            if(c < 0x80) {
+                dst[0] = charT(c);
+            } else if(c < 0x800) {
+                dst[0] = charT(0xc0 | c >> 6);
+                dst[1] = charT(0x80 | (c & 0x3f));
+            } else if(c < 0x10000) {
+                dst[0] = charT(0xe0 | c >> 12);
+                dst[1] = charT(0x80 | (c >> 6 & 0x3f));
+                dst[2] = charT(0x80 | (c & 0x3f));
+            } else {
+                dst[0] = charT(0xf0 | c >> 18);
+                dst[1] = charT(0x80 | (c >> 12 & 0x3f));
+                dst[2] = charT(0x80 | (c >> 6 & 0x3f));
+                dst[3] = charT(0x80 | (c & 0x3f));
+            }
+        } else if constexpr(__utf_width<charT> == 2) {
+            if(c < 0x10000) {
+                dst[0] = charT(c);
+            } else {
+                dst[0] = charT(0xd800 + ((c - 0x10000) >> 10));
+                dst[1] = charT(0xdc00 + ((c - 0x10000) & 0x3ff));
+            }
+        } else {
+            dst[0] = charT(c);
+        }
+    }
+
+    // ASCII code units are the same value in every encoding, so a run of them converts one to one. The kernels below
+    // convert whole blocks of ASCII from the start of src, stopping at the first block holding anything else, and
+    // return the number of code units converted. Unlike the scan kernels they stay within the n code units given.
+    #ifdef ZSTRING_VIEW_X86_SIMD
+    // One bit per byte of v, set for bytes of code units of Width bytes that are not ASCII
+    template<size_t Width>
+    ZSTRING_VIEW_ALWAYS_INLINE uint32_t __non_ascii_sse2(__m128i v) noexcept {
+        if constexpr(Width == 1) {
+            return static_cast<uint32_t>(_mm_movemask_epi8(v));
+        } else {
+            const __m128i high_bits = Width == 2 ? _mm_set1_epi16(short(0xff80)) : _mm_set1_epi32(int(0xffffff80));
+            return ~static_cast<uint32_t>(
+                _mm_movemask_epi8(__cmpeq_sse2<Width>(_mm_and_si128(v, high_bits), _mm_setzero_si128()))
+            ) & 0xffff;
+        }
+    }
+
+    template<size_t Width>
+    ZSTRING_VIEW_ALWAYS_INLINE ZSTRING_VIEW_TARGET_AVX2 bool __is_ascii_avx2(__m256i v) noexcept {
+        const __m256i high_bits =
+            Width == 1 ? _mm256_set1_epi8(char(0x80))
+            : Width == 2 ? _mm256_set1_epi16(short(0xff80))
+            : _mm256_set1_epi32(int(0xffffff80));
+        return _mm256_testz_si256(v, high_bits);
+    }
+
+    // Number of leading code units of src in whole ASCII blocks
+    template<size_t Width>
+    inline size_t __ascii_prefix_sse2(const void* src, size_t n) noexcept {
+        const char* p = static_cast<const char*>(src);
+        constexpr size_t block = 16 / Width;
+        size_t i = 0;
+        for(; n - i >= block; i += block) {
+            if(__non_ascii_sse2<Width>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * Width)))) {
+                break;
+            }
+        }
+        return i;
+    }
+
+    template<size_t Width>
+    ZSTRING_VIEW_TARGET_AVX2 inline size_t __ascii_prefix_avx2(const void* src, size_t n) noexcept {
+        const char* p = static_cast<const char*>(src);
+        constexpr size_t block = 64 / Width;
+        size_t i = 0;
+        for(; n - i >= block; i += block) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i * Width));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i * Width + 32));
+            if(!__is_ascii_avx2<Width>(_mm256_or_si256(a, b))) {
+                break;
+            }
+        }
+        return i;
+    }
+
+    template<size_t FromWidth, size_t ToWidth>
+    inline size_t __convert_ascii_sse2(const void* src, size_t n, void* dst) noexcept {
+        const char* in = static_cast<const char*>(src);
+        char* out = static_cast<char*>(dst);
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for(; n - i >= 16; i += 16) {
+            const char* s = in + i * FromWidth;
+            char* d = out + i * ToWidth;
+            if constexpr(FromWidth == 1) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+                if(_mm_movemask_epi8(v)) {
+                    break;
+                }
+                const __m128i low = _mm_unpacklo_epi8(v, zero);
+                const __m128i high = _mm_unpackhi_epi8(v, zero);
+                if constexpr(ToWidth == 2) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(d), low);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 16), high);
+                } else {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(d), _mm_unpacklo_epi16(low, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 16), _mm_unpackhi_epi16(low, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 32), _mm_unpacklo_epi16(high, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 48), _mm_unpackhi_epi16(high, zero));
+                }
+            } else if constexpr(FromWidth == 2) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+                if(__non_ascii_sse2<2>(_mm_or_si128(a, b))) {
+                    break;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d), _mm_packus_epi16(a, b));
+            } else {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+                const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+                if(__non_ascii_sse2<4>(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, e)))) {
+                    break;
+                }
+                // The values are below 0x80, so signed saturation leaves them unchanged
+                const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, e));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d), packed);
+            }
+        }
+        return i;
+    }
+
+    template<size_t FromWidth, size_t ToWidth>
+    ZSTRING_VIEW_TARGET_AVX2 inline size_t __convert_ascii_avx2(const void* src, size_t n, void* dst) noexcept {
+        const char* in = static_cast<const char*>(src);
+        char* out = static_cast<char*>(dst);
+        size_t i = 0;
+        for(; n - i >= 32; i += 32) {
+            const char* s = in + i * FromWidth;
+            char* d = out + i * ToWidth;
+            if constexpr(FromWidth == 1) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+                if(_mm256_movemask_epi8(v)) {
+                    break;
+                }
+                const __m128i low = _mm256_castsi256_si128(v);
+                const __m128i high = _mm256_extracti128_si256(v, 1);
+                if constexpr(ToWidth == 2) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), _mm256_cvtepu8_epi16(low));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 32), _mm256_cvtepu8_epi16(high));
+                } else {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), _mm256_cvtepu8_epi32(low));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 32), _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 64), _mm256_cvtepu8_epi32(high));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 96), _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+                }
+            } else if constexpr(FromWidth == 2) {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+                if(!__is_ascii_avx2<2>(_mm256_or_si256(a, b))) {
+                    break;
+                }
+                // packus works within 128-bit lanes, leaving the quarters in the order a0 b0 a1 b1
+                const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xd8);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), packed);
+            } else {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+                const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 64));
+                const __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 96));
+                if(!__is_ascii_avx2<4>(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, e)))) {
+                    break;
+                }
+                // Within each lane the packs leave four units of each of a, b, c and e in turn
+                const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, e));
+                const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), _mm256_permutevar8x32_epi32(packed, order));
+            }
+        }
+        return i;
+    }
+    #endif
+
+    // Number of leading code units of src, at most n, in whole ASCII blocks
+    template<class charT>
+    inline size_t __ascii_prefix(const charT* src, size_t n) noexcept {
+        #ifdef ZSTRING_VIEW_X86_SIMD
+        return __has_avx2 ? __ascii_prefix_avx2<__utf_width<charT>>(src, n) : __ascii_prefix_sse2<__utf_width<charT>>(src, n);
+        #else
+        (void)src;
+        (void)n;
+        return 0;
+        #endif
+    }
+
+    // Converts the leading code units of src, at most n, in whole ASCII blocks to dst and returns how many there were
+    template<class To, class From>
+    inline size_t __convert_ascii(const From* src, size_t n, To* dst) noexcept {
+        constexpr size_t from = __utf_width<From>;
+        constexpr size_t to = __utf_width<To>;
+        if constexpr(from == to) {
+            const size_t count = __ascii_prefix(src, n);
+            char_traits<To>::copy(dst, reinterpret_cast<const To*>(src), count);
+            return count;
+        } else if constexpr(from == 1 || to == 1) {
+            #ifdef ZSTRING_VIEW_X86_SIMD
+            return __has_avx2 ? __convert_ascii_avx2<from, to>(src, n, dst) : __convert_ascii_sse2<from, to>(src, n, dst);
+            #endif
+        }
+        // UTF-16 <-> UTF-32 has no vector path
+        (void)src;
+        (void)n;
+        (void)dst;
+        return 0;
+    }
+
+    // After a vector kernel stops short the next __scalar_stretch code units are decoded one at a time, in a loop
+    // free of calls, before it is tried again. Text with scattered non-ASCII characters then doesn't pay for a failed
+    // vector attempt at every ASCII character.
+    inline constexpr size_t __scalar_stretch = 64;
+
+    template<class To, class From>
+    constexpr transcoded_length_result __transcoded_length(const From* src, size_t size) noexcept {
+        size_t i = 0;
+        size_t length = 0;
+        while(i < size) {
+            if(!is_constant_evaluated() && __unit(src[i]) < 0x80) {
+                const size_t count = __ascii_prefix(src + i, size - i);
+                i += count;
+                length += count;
+            }
+            for(const size_t stop = std::min(size, i + __scalar_stretch); i < stop; ) {
+                const char32_t c = __decode(src, size, i);
+                if(c == __invalid_code_point) {
+                    return {length, i, errc::illegal_byte_sequence};
+                }
+                length += __encoded_length<To>(c);
+            }
+        }
+        return {length, i, errc()};
+    }
+
+    // Converts src into dst, which has room for capacity code units and the terminator
+    template<class To, class From>
+    constexpr transcode_result<To> __transcode(const From* src, size_t size, To* dst, size_t capacity) noexcept {
+        size_t i = 0;
+        size_t o = 0;
+        errc ec = errc();
+        while(i < size && ec == errc()) {
+            if(!is_constant_evaluated() && __unit(src[i]) < 0x80) {
+                const size_t count = __convert_ascii(src + i, std::min(size - i, capacity - o), dst + o);
+                i += count;
+                o += count;
+            }
+            for(const size_t stop = std::min(size, i + __scalar_stretch); i < stop; ) {
+                size_t next = i;
+                const char32_t c = __decode(src, size, next);
+                if(c == __invalid_code_point) {
+                    ec = errc::illegal_byte_sequence;
+                    break;
+                }
+                const size_t length = __encoded_length<To>(c);
+                if(capacity - o < length) {
+                    ec = errc::value_too_large;
+                    break;
+                }
+                __encode(c, dst + o);
+                i = next;
+                o += length;
+            }
+        }
+        dst[o] = To();
+        return {basic_zstring_view<To>(dst, o), i, ec};
+    }
+}
+
+namespace std {
+    // Validates src and computes the size of its transcoding to To, excluding the terminator
+    template<class To, class From>
+        requires __zsv::__utf_char<To> && __zsv::__utf_char<From>
+    constexpr transcoded_length_result transcoded_length(basic_zstring_view<From> src) noexcept {
+        return __zsv::__transcoded_length<To>(src.data(), src.size());
+    }
+
+    // Transcodes src into buffer, which must not be empty. Output that doesn't fit along with the terminator stops the
+    // conversion with errc::value_too_large at a code point boundary; on any error str holds what was converted.
+    template<class To, class From>
+        requires __zsv::__utf_char<To> && __zsv::__utf_char<From>
+    constexpr transcode_result<To> transcode(basic_zstring_view<From> src, span<To> buffer) noexcept {
+        assert(!buffer.empty());
+        return __zsv::__transcode(src.data(), src.size(), buffer.data(), buffer.size() - 1);
+    }
+
+    // Transcodes src into arena storage sized by transcoded_length. Nothing is allocated for ill-formed input, for
+    // which str is empty.
+    template<class To, class From, class Allocator>
+        requires __zsv::__utf_char<To> && __zsv::__utf_char<From>
+    transcode_result<To> transcode(basic_zstring_view<From> src, basic_zstring_arena<To, char_traits<To>, Allocator>& arena) {
+        const transcoded_length_result length = transcoded_length<To>(src);
+        if(length.ec != errc()) {
+            return {basic_zstring_view<To>(), length.position, length.ec};
+        }
+        if(arena.deduplicating()) {
+            // The output may already be stored, so it can't be transcoded into arena storage first
+            basic_string<To> temporary(length.size, To());
+            transcode_result<To> result = __zsv::__transcode(src.data(), src.size(), temporary.data(), length.size);
+            result.str = arena.store(result.str);
+            return result;
+        }
+        To* data = arena.allocate(length.size + 1);
+        return __zsv::__transcode(src.data(), src.size(), data, length.size);
+    }
+}
+
+#endif
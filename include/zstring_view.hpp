@@ -1,13 +1,39 @@
 #ifndef ZSTRING_VIEW_HPP
 #define ZSTRING_VIEW_HPP
 
+#include <bit>
 #include <cassert>
 #include <compare>
+#include <cstdint>
 #include <ranges>
 #include <stdexcept>
 #include <string_view>
 #include <string>
 #include <format>
+#include <optional>
+#include <type_traits>
+
+// NOTE: Not part of proposal. Vectorized kernels are used for x86-64 unless ZSTRING_VIEW_NO_SIMD is defined.
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(ZSTRING_VIEW_NO_SIMD)
+ #define ZSTRING_VIEW_X86_SIMD
+ #include <immintrin.h>
+ #ifdef _MSC_VER
+  #include <intrin.h>
+ #endif
+#endif
+
+// NOTE: Not part of proposal. Defining ZSTRING_VIEW_INSTRUMENT counts length scans, string_view conversions and at()
+// throws per call site and reports them at exit, see zstring_view_instrument.hpp. Constructors and at() take the call
+// site as an extra defaulted parameter. A literal operator can't take one, so "..."zsv views, like default-constructed
+// ones, have an unknown call site. Without the macro nothing changes.
+#ifdef ZSTRING_VIEW_INSTRUMENT
+ #include "zstring_view_instrument.hpp"
+ #define ZSTRING_VIEW_CALL_SITE , source_location __site = source_location::current()
+ #define ZSTRING_VIEW_UNKNOWN_CALL_SITE , source_location()
+#else
+ #define ZSTRING_VIEW_CALL_SITE
+ #define ZSTRING_VIEW_UNKNOWN_CALL_SITE
+#endif
 
 namespace std {
     // [zstring.view.template], class template basic_zstring_view
@@ -81,6 +107,390 @@ namespace std {
     }
 }
 
+// NOTE: Not part of proposal, implementation details for the vectorized kernels.
+namespace std::__zsv {
+    #ifdef ZSTRING_VIEW_X86_SIMD
+     #if defined(__GNUC__) || defined(__clang__)
+      #define ZSTRING_VIEW_ALWAYS_INLINE __attribute__((always_inline)) inline
+      #define ZSTRING_VIEW_TARGET_AVX2 __attribute__((target("avx2")))
+      // Kernels read whole aligned vectors, which can extend past the terminator but never into another page
+      #define ZSTRING_VIEW_OVERREAD __attribute__((no_sanitize_address))
+     #else
+      #define ZSTRING_VIEW_ALWAYS_INLINE __forceinline
+      #define ZSTRING_VIEW_TARGET_AVX2
+      #define ZSTRING_VIEW_OVERREAD
+     #endif
+
+    inline bool __detect_avx2() noexcept {
+        #if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+        #else
+        int info[4];
+        __cpuid(info, 0);
+        if(info[0] < 7) {
+            return false;
+        }
+        __cpuid(info, 1);
+        constexpr int osxsave = 1 << 27;
+        constexpr int avx = 1 << 28;
+        if((info[2] & osxsave) == 0 || (info[2] & avx) == 0 || (_xgetbv(0) & 6) != 6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+        #endif
+    }
+
+    // Zero until dynamic initialization runs, so kernels used from other static initializers fall back to SSE2
+    inline const bool __has_avx2 = __detect_avx2();
+
+    // Scans forward from str one aligned vector at a time. match(block) returns a bitmask with one bit per byte of
+    // the VectorSize-byte block. Aligned loads never cross a page boundary so the scan may safely read past the end of
+    // the string as long as something (e.g. the terminator) is guaranteed to match. Returns the index, in code units
+    // of Width bytes, of the first match. str must be aligned to Width.
+    template<size_t Width, size_t VectorSize, class Matcher>
+    ZSTRING_VIEW_ALWAYS_INLINE ZSTRING_VIEW_OVERREAD size_t __aligned_scan(const void* str, const Matcher& match) {
+        const char* start = static_cast<const char*>(str);
+        const size_t misalignment = reinterpret_cast<uintptr_t>(start) & (VectorSize - 1);
+        const char* block = start - misalignment;
+        uint32_t mask = match(block) >> misalignment;
+        if(mask) {
+            return countr_zero(mask) / Width;
+        }
+        while(true) {
+            block += VectorSize;
+            mask = match(block);
+            if(mask) {
+                return (static_cast<size_t>(block - start) + countr_zero(mask)) / Width;
+            }
+        }
+    }
+
+    template<size_t Width>
+    ZSTRING_VIEW_ALWAYS_INLINE __m128i __cmpeq_sse2(__m128i a, __m128i b) {
+        if constexpr(Width == 1) {
+            return _mm_cmpeq_epi8(a, b);
+        } else if constexpr(Width == 2) {
+            return _mm_cmpeq_epi16(a, b);
+        } else {
+            return _mm_cmpeq_epi32(a, b);
+        }
+    }
+
+    template<size_t Width>
+    ZSTRING_VIEW_ALWAYS_INLINE ZSTRING_VIEW_TARGET_AVX2 __m256i __cmpeq_avx2(__m256i a, __m256i b) {
+        if constexpr(Width == 1) {
+            return _mm256_cmpeq_epi8(a, b);
+        } else if constexpr(Width == 2) {
+            return _mm256_cmpeq_epi16(a, b);
+        } else {
+            return _mm256_cmpeq_epi32(a, b);
+        }
+    }
+
+    template<size_t Width>
+    ZSTRING_VIEW_OVERREAD inline size_t __length_sse2(const void* str) noexcept {
+        return __aligned_scan<Width, 16>(str, [](const char* block) ZSTRING_VIEW_OVERREAD {
+            __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+            return static_cast<uint32_t>(_mm_movemask_epi8(__cmpeq_sse2<Width>(v, _mm_setzero_si128())));
+        });
+    }
+
+    template<size_t Width>
+    ZSTRING_VIEW_TARGET_AVX2 ZSTRING_VIEW_OVERREAD inline size_t __length_avx2(const void* str) noexcept {
+        return __aligned_scan<Width, 32>(str, [](const char* block) ZSTRING_VIEW_TARGET_AVX2 ZSTRING_VIEW_OVERREAD {
+            __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+            return static_cast<uint32_t>(_mm256_movemask_epi8(__cmpeq_avx2<Width>(v, _mm256_setzero_si256())));
+        });
+    }
+
+    template<size_t Width, class Unit>
+    ZSTRING_VIEW_ALWAYS_INLINE __m128i __broadcast_sse2(Unit c) {
+        if constexpr(Width == 1) {
+            return _mm_set1_epi8(static_cast<char>(c));
+        } else if constexpr(Width == 2) {
+            return _mm_set1_epi16(static_cast<short>(c));
+        } else {
+            return _mm_set1_epi32(static_cast<int>(c));
+        }
+    }
+
+    template<size_t Width, class Unit>
+    ZSTRING_VIEW_ALWAYS_INLINE ZSTRING_VIEW_TARGET_AVX2 __m256i __broadcast_avx2(Unit c) {
+        if constexpr(Width == 1) {
+            return _mm256_set1_epi8(static_cast<char>(c));
+        } else if constexpr(Width == 2) {
+            return _mm256_set1_epi16(static_cast<short>(c));
+        } else {
+            return _mm256_set1_epi32(static_cast<int>(c));
+        }
+    }
+
+    // Index of the first code unit equal to c or to the terminator
+    template<size_t Width, class Unit>
+    ZSTRING_VIEW_OVERREAD inline size_t __find_unit_sse2(const void* str, Unit c) noexcept {
+        const __m128i needle = __broadcast_sse2<Width>(c);
+        return __aligned_scan<Width, 16>(str, [needle](const char* block) ZSTRING_VIEW_OVERREAD {
+            __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+            __m128i hits = _mm_or_si128(__cmpeq_sse2<Width>(v, needle), __cmpeq_sse2<Width>(v, _mm_setzero_si128()));
+            return static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        });
+    }
+
+    template<size_t Width, class Unit>
+    ZSTRING_VIEW_TARGET_AVX2 ZSTRING_VIEW_OVERREAD inline size_t __find_unit_avx2(const void* str, Unit c) noexcept {
+        const __m256i needle = __broadcast_avx2<Width>(c);
+        return __aligned_scan<Width, 32>(str, [needle](const char* block) ZSTRING_VIEW_TARGET_AVX2 ZSTRING_VIEW_OVERREAD {
+            __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+            __m256i hits = _mm256_or_si256(
+                __cmpeq_avx2<Width>(v, needle),
+                __cmpeq_avx2<Width>(v, _mm256_setzero_si256())
+            );
+            return static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        });
+    }
+    #endif
+
+    // The kernels assume the standard character semantics, i.e. code unit equality is bitwise equality
+    template<class charT, class traits>
+    inline constexpr bool __is_default_traits = is_same_v<traits, char_traits<charT>>;
+
+    // Whether to use the vector kernels in place of traits::length and traits::find. The C library's strlen/memchr, and
+    // wcslen/wmemchr where wchar_t is 4 bytes, are already vectorized; char_traits<char16_t> and char_traits<char32_t>
+    // are typically scalar loops.
+    template<class charT, class traits>
+    inline constexpr bool __use_scan_kernels =
+        __is_default_traits<charT, traits>
+        && (is_same_v<charT, char16_t> || is_same_v<charT, char32_t> || (is_same_v<charT, wchar_t> && sizeof(wchar_t) == 2));
+
+    // traits::length, vectorized where the standard library isn't
+    template<class charT, class traits>
+    constexpr size_t __length(const charT* str) {
+        #ifdef ZSTRING_VIEW_X86_SIMD
+        if constexpr(__use_scan_kernels<charT, traits>) {
+            if(!is_constant_evaluated() && reinterpret_cast<uintptr_t>(str) % sizeof(charT) == 0) {
+                return __has_avx2 ? __length_avx2<sizeof(charT)>(str) : __length_sse2<sizeof(charT)>(str);
+            }
+        }
+        #endif
+        return traits::length(str);
+    }
+
+    // A set of code units below 256
+    struct __byte_set {
+        bool members[256]{};
+
+        constexpr void insert(uint32_t c) noexcept {
+            members[c] = true;
+        }
+        constexpr bool contains(uint32_t c) const noexcept {
+            return c < 256 && members[c];
+        }
+    };
+
+    template<class charT>
+    constexpr uint32_t __unit(charT c) noexcept {
+        return static_cast<make_unsigned_t<charT>>(c);
+    }
+
+    // Builds the set, failing if it holds code units that don't fit in a __byte_set
+    template<class charT>
+    constexpr bool __make_byte_set(basic_string_view<charT> chars, __byte_set& set) noexcept {
+        for(charT c : chars) {
+            if(__unit(c) >= 256) {
+                return false;
+            }
+            set.insert(__unit(c));
+        }
+        return true;
+    }
+
+    #ifdef ZSTRING_VIEW_X86_SIMD
+    // Set membership for 32 bytes at a time by looking up the low nibble of each byte in a table of which high nibbles
+    // are members (one table for each half of the high nibble range) and testing the high nibble's bit.
+    struct __nibble_set {
+        __m256i low_half;  // bit h set in entry l if (h << 4 | l) is a member, for h < 8
+        __m256i high_half; // likewise for h >= 8, as bit h - 8
+        __m256i high_bit;  // entry h is 1 << (h & 7)
+
+        ZSTRING_VIEW_TARGET_AVX2 explicit __nibble_set(const __byte_set& set) noexcept {
+            alignas(16) uint8_t low[16]{};
+            alignas(16) uint8_t high[16]{};
+            alignas(16) uint8_t bit[16];
+            for(uint32_t base = 0; base < 256; base += 32) {
+                __m256i members = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(set.members + base));
+                uint32_t mask = ~static_cast<uint32_t>(
+                    _mm256_movemask_epi8(_mm256_cmpeq_epi8(members, _mm256_setzero_si256()))
+                );
+                for(; mask; mask &= mask - 1) {
+                    const uint32_t c = base + countr_zero(mask);
+                    (c < 128 ? low : high)[c & 15] |= uint8_t(1 << ((c >> 4) & 7));
+                }
+            }
+            for(uint32_t h = 0; h < 16; h++) {
+                bit[h] = uint8_t(1 << (h & 7));
+            }
+            low_half = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(low)));
+            high_half = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(high)));
+            high_bit = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(bit)));
+        }
+
+        // One bit per byte, set for bytes that are not members
+        ZSTRING_VIEW_ALWAYS_INLINE ZSTRING_VIEW_TARGET_AVX2 uint32_t non_members(__m256i v) const noexcept {
+            // pshufb yields zero for indices with the top bit set, which selects the right table for each byte
+            __m256i high_nibble = _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+            __m256i in_low = _mm256_shuffle_epi8(low_half, v);
+            __m256i in_high = _mm256_shuffle_epi8(high_half, _mm256_xor_si256(v, _mm256_set1_epi8(char(0x80))));
+            __m256i hits = _mm256_and_si256(_mm256_or_si256(in_low, in_high), _mm256_shuffle_epi8(high_bit, high_nibble));
+            return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hits, _mm256_setzero_si256())));
+        }
+    };
+
+    // Index of the first byte that is (or, if negate, is not) in the set. The scan must be guaranteed to stop, e.g.
+    // by the terminator being a member (or a non-member if negate).
+    template<bool negate>
+    ZSTRING_VIEW_TARGET_AVX2 ZSTRING_VIEW_OVERREAD inline size_t __find_set_avx2(
+        const char* str,
+        const __byte_set& set
+    ) noexcept {
+        const __nibble_set nibbles(set);
+        return __aligned_scan<1, 32>(str, [&nibbles](const char* block) ZSTRING_VIEW_TARGET_AVX2 ZSTRING_VIEW_OVERREAD {
+            uint32_t mask = nibbles.non_members(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)));
+            return negate ? mask : ~mask;
+        });
+    }
+
+    // Below this many code units setting up the nibble tables costs more than it saves. Matches are often close to the
+    // start so the first __find_set_simd_head code units are checked before the tables are built.
+    inline constexpr size_t __find_set_simd_threshold = 64;
+    inline constexpr size_t __find_set_simd_head = 16;
+    #endif
+
+    // The search kernels below use the terminator as the loop sentinel, data[size] == charT() being the invariant of
+    // basic_zstring_view, instead of checking bounds on every code unit. A terminator found before data + size is an
+    // embedded null and the scan resumes after it. They defer to basic_string_view during constant evaluation and for
+    // custom traits.
+
+    // Index of the first code unit equal to c or to the terminator
+    template<class charT>
+    inline size_t __find_unit_or_terminator(const charT* str, charT c) noexcept {
+        #ifdef ZSTRING_VIEW_X86_SIMD
+        if(reinterpret_cast<uintptr_t>(str) % sizeof(charT) == 0) {
+            return __has_avx2 ? __find_unit_avx2<sizeof(charT)>(str, c) : __find_unit_sse2<sizeof(charT)>(str, c);
+        }
+        #endif
+        const charT* p = str;
+        while(*p != c && *p != charT()) {
+            ++p;
+        }
+        return p - str;
+    }
+
+    template<class charT, class traits>
+    constexpr size_t __find(const charT* data, size_t size, charT c, size_t pos) noexcept {
+        if constexpr(__use_scan_kernels<charT, traits>) {
+            if(!is_constant_evaluated() && c != charT()) {
+                if(pos >= size) {
+                    return basic_string_view<charT, traits>::npos;
+                }
+                while(true) {
+                    pos += __find_unit_or_terminator(data + pos, c);
+                    if(data[pos] == c) {
+                        return pos;
+                    }
+                    if(pos == size) {
+                        return basic_string_view<charT, traits>::npos;
+                    }
+                    pos++;
+                }
+            }
+        }
+        return basic_string_view<charT, traits>(data, size).find(c, pos);
+    }
+
+    template<class charT, class traits>
+    constexpr size_t __find_first_of(
+        const charT* data,
+        size_t size,
+        basic_string_view<charT, traits> chars,
+        size_t pos
+    ) noexcept {
+        if constexpr(__is_default_traits<charT, traits>) {
+            __byte_set set;
+            if(!is_constant_evaluated() && __make_byte_set<charT>(chars, set)) {
+                if(pos >= size || chars.empty()) {
+                    return basic_string_view<charT, traits>::npos;
+                }
+                const bool null_is_member = set.contains(0);
+                set.insert(0);
+                while(true) {
+                    #ifdef ZSTRING_VIEW_X86_SIMD
+                    if constexpr(sizeof(charT) == 1) {
+                        if(__has_avx2 && size - pos >= __find_set_simd_threshold) {
+                            const size_t head_end = pos + __find_set_simd_head;
+                            while(pos != head_end && !set.contains(__unit(data[pos]))) {
+                                pos++;
+                            }
+                            if(pos == head_end) {
+                                pos += __find_set_avx2<false>(reinterpret_cast<const char*>(data + pos), set);
+                            }
+                        }
+                    }
+                    #endif
+                    while(!set.contains(__unit(data[pos]))) {
+                        pos++;
+                    }
+                    if(data[pos] != charT() || (null_is_member && pos != size)) {
+                        return pos;
+                    }
+                    if(pos == size) {
+                        return basic_string_view<charT, traits>::npos;
+                    }
+                    pos++;
+                }
+            }
+        }
+        return basic_string_view<charT, traits>(data, size).find_first_of(chars, pos);
+    }
+
+    template<class charT, class traits>
+    constexpr size_t __find_first_not_of(
+        const charT* data,
+        size_t size,
+        basic_string_view<charT, traits> chars,
+        size_t pos
+    ) noexcept {
+        if constexpr(__is_default_traits<charT, traits>) {
+            __byte_set set;
+            // The terminator has to end the scan so it can't be a member
+            if(!is_constant_evaluated() && __make_byte_set<charT>(chars, set) && !set.contains(0)) {
+                if(pos >= size) {
+                    return basic_string_view<charT, traits>::npos;
+                }
+                #ifdef ZSTRING_VIEW_X86_SIMD
+                if constexpr(sizeof(charT) == 1) {
+                    if(__has_avx2 && size - pos >= __find_set_simd_threshold) {
+                        const size_t head_end = pos + __find_set_simd_head;
+                        while(pos != head_end && set.contains(__unit(data[pos]))) {
+                            pos++;
+                        }
+                        if(pos == head_end) {
+                            pos += __find_set_avx2<true>(reinterpret_cast<const char*>(data + pos), set);
+                        }
+                    }
+                }
+                #endif
+                while(set.contains(__unit(data[pos]))) {
+                    pos++;
+                }
+                return pos == size ? basic_string_view<charT, traits>::npos : pos;
+            }
+        }
+        return basic_string_view<charT, traits>(data, size).find_first_not_of(chars, pos);
+    }
+}
+
 namespace std {
     template<class charT, class traits /* = char_traits<charT> */>
     class basic_zstring_view {
@@ -107,17 +517,36 @@ namespace std {
         }
         constexpr basic_zstring_view(const basic_zstring_view&) noexcept = default;
         constexpr basic_zstring_view& operator=(const basic_zstring_view&) noexcept = default;
-        constexpr basic_zstring_view(const charT* str) : basic_zstring_view(str, traits::length(str)) {}
-        constexpr basic_zstring_view(const charT* str, size_type len) : data_(str), size_(len) {
+        constexpr basic_zstring_view(const charT* str ZSTRING_VIEW_CALL_SITE)
+            : basic_zstring_view(str, __zsv::__length<charT, traits>(str)) {
+            #ifdef ZSTRING_VIEW_INSTRUMENT
+            origin_ = __site;
+            if(!is_constant_evaluated()) {
+                __zsv::__instrument_registry::instance().record(
+                    __site,
+                    __zsv::__instrument_registry::__event::length_scan,
+                    (size_ + 1) * sizeof(charT)
+                );
+            }
+            #endif
+        }
+        constexpr basic_zstring_view(const charT* str, size_type len ZSTRING_VIEW_CALL_SITE) : data_(str), size_(len) {
             assert(str[len] == charT());
+            #ifdef ZSTRING_VIEW_INSTRUMENT
+            origin_ = __site;
+            #endif
         }
         basic_zstring_view(nullptr_t) = delete;
 
         // NOTE: Not part of proposal, just to make examples work since I can't add the conversion operator to
         // basic_string.
         template<typename Traits, typename Allocator>
-        constexpr basic_zstring_view(const std::basic_string<charT, Traits, Allocator>& str)
-            : basic_zstring_view(str.c_str(), str.size()) {}
+        constexpr basic_zstring_view(const std::basic_string<charT, Traits, Allocator>& str ZSTRING_VIEW_CALL_SITE)
+            : basic_zstring_view(str.c_str(), str.size()) {
+            #ifdef ZSTRING_VIEW_INSTRUMENT
+            origin_ = __site;
+            #endif
+        }
 
         // [zstring.view.iterators], iterator support
         constexpr const_iterator begin() const noexcept {
@@ -164,8 +593,13 @@ namespace std {
             assert(pos <= size_);
             return data_[pos];
         }
-        constexpr const_reference at(size_type pos) const {
+        constexpr const_reference at(size_type pos ZSTRING_VIEW_CALL_SITE) const {
             if(pos > size_) {
+                #ifdef ZSTRING_VIEW_INSTRUMENT
+                if(!is_constant_evaluated()) {
+                    __zsv::__instrument_registry::instance().record(__site, __zsv::__instrument_registry::__event::at_throw);
+                }
+                #endif
                 throw std::out_of_range(std::format("basic_zstring_view::at: pos ({}) > size() {}", pos, size_));
             }
             return data_[pos];
@@ -185,7 +619,12 @@ namespace std {
             return data_;
         }
 
-        operator basic_string_view<charT, traits>() const noexcept {
+        constexpr operator basic_string_view<charT, traits>() const noexcept {
+            #ifdef ZSTRING_VIEW_INSTRUMENT
+            if(!is_constant_evaluated()) {
+                __zsv::__instrument_registry::instance().record(origin_, __zsv::__instrument_registry::__event::conversion);
+            }
+            #endif
             return basic_string_view<charT, traits>{data_, size_};
         }
 
@@ -209,6 +648,42 @@ namespace std {
             return basic_string_view<charT, traits>(*this).substr(pos, n);
         }
 
+        // NOTE: Not part of proposal. Tails of a zstring are null-terminated, so these keep the zstring_view type
+        // where substr would degrade to basic_string_view.
+        constexpr basic_zstring_view zsubstr(size_type pos = 0) const {
+            if(pos > size_) {
+                throw std::out_of_range(std::format("basic_zstring_view::zsubstr: pos ({}) > size() {}", pos, size_));
+            }
+            return basic_zstring_view(data_ + pos, size_ - pos);
+        }
+        // The part after the first / last occurrence of c, if c occurs
+        constexpr optional<basic_zstring_view> after_first(charT c) const noexcept {
+            const size_type pos = find(c);
+            if(pos == npos) {
+                return nullopt;
+            }
+            return basic_zstring_view(data_ + pos + 1, size_ - pos - 1);
+        }
+        constexpr optional<basic_zstring_view> after_last(charT c) const noexcept {
+            const size_type pos = rfind(c);
+            if(pos == npos) {
+                return nullopt;
+            }
+            return basic_zstring_view(data_ + pos + 1, size_ - pos - 1);
+        }
+        // The part after prefix, if the string starts with it
+        constexpr optional<basic_zstring_view> strip_prefix(basic_string_view<charT, traits> prefix) const noexcept {
+            if(!starts_with(prefix)) {
+                return nullopt;
+            }
+            return basic_zstring_view(data_ + prefix.size(), size_ - prefix.size());
+        }
+        // The part after the last '/', or the whole string if there is none. Unlike POSIX basename(), a trailing '/'
+        // yields an empty string.
+        constexpr basic_zstring_view basename() const noexcept {
+            return after_last(charT('/')).value_or(*this);
+        }
+
         constexpr int compare(basic_string_view<charT, traits> s) const noexcept {
             return basic_string_view<charT, traits>(*this).compare(s);
         }
@@ -252,7 +727,7 @@ namespace std {
             return basic_string_view<charT, traits>(*this).contains(x);
         }
         constexpr bool contains(charT x) const noexcept {
-            return basic_string_view<charT, traits>(*this).contains(x);
+            return find(x) != npos;
         }
         constexpr bool contains(const charT* x) const {
             return basic_string_view<charT, traits>(*this).contains(x);
@@ -263,7 +738,7 @@ namespace std {
             return basic_string_view<charT, traits>(*this).find(s, pos);
         }
         constexpr size_type find(charT c, size_type pos = 0) const noexcept {
-            return basic_string_view<charT, traits>(*this).find(c, pos);
+            return __zsv::__find<charT, traits>(data_, size_, c, pos);
         }
         constexpr size_type find(const charT* s, size_type pos, size_type n) const {
             return basic_string_view<charT, traits>(*this).find(s, pos, n);
@@ -285,16 +760,16 @@ namespace std {
         }
 
         constexpr size_type find_first_of(basic_string_view<charT, traits> s, size_type pos = 0) const noexcept {
-            return basic_string_view<charT, traits>(*this).find_first_of(s, pos);
+            return __zsv::__find_first_of<charT, traits>(data_, size_, s, pos);
         }
         constexpr size_type find_first_of(charT c, size_type pos = 0) const noexcept {
-            return basic_string_view<charT, traits>(*this).find_first_of(c, pos);
+            return find(c, pos);
         }
         constexpr size_type find_first_of(const charT* s, size_type pos, size_type n) const {
-            return basic_string_view<charT, traits>(*this).find_first_of(s, pos, n);
+            return find_first_of(basic_string_view<charT, traits>(s, n), pos);
         }
         constexpr size_type find_first_of(const charT* s, size_type pos = 0) const {
-            return basic_string_view<charT, traits>(*this).find_first_of(s, pos);
+            return find_first_of(basic_string_view<charT, traits>(s), pos);
         }
         constexpr size_type find_last_of(basic_string_view<charT, traits> s, size_type pos = npos) const noexcept {
             return basic_string_view<charT, traits>(*this).find_last_of(s, pos);
@@ -309,16 +784,16 @@ namespace std {
             return basic_string_view<charT, traits>(*this).find_last_of(s, pos);
         }
         constexpr size_type find_first_not_of(basic_string_view<charT, traits> s, size_type pos = 0) const noexcept {
-            return basic_string_view<charT, traits>(*this).find_first_not_of(s, pos);
+            return __zsv::__find_first_not_of<charT, traits>(data_, size_, s, pos);
         }
         constexpr size_type find_first_not_of(charT c, size_type pos = 0) const noexcept {
-            return basic_string_view<charT, traits>(*this).find_first_not_of(c, pos);
+            return find_first_not_of(basic_string_view<charT, traits>(&c, 1), pos);
         }
         constexpr size_type find_first_not_of(const charT* s, size_type pos, size_type n) const {
-            return basic_string_view<charT, traits>(*this).find_first_not_of(s, pos, n);
+            return find_first_not_of(basic_string_view<charT, traits>(s, n), pos);
         }
         constexpr size_type find_first_not_of(const charT* s, size_type pos = 0) const {
-            return basic_string_view<charT, traits>(*this).find_first_not_of(s, pos);
+            return find_first_not_of(basic_string_view<charT, traits>(s), pos);
         }
         constexpr size_type find_last_not_of(basic_string_view<charT, traits> s, size_type pos = npos) const noexcept {
             return basic_string_view<charT, traits>(*this).find_last_not_of(s, pos);
@@ -336,6 +811,9 @@ namespace std {
     private:
         const_pointer data_;        // exposition only
         size_type size_;            // exposition only
+        #ifdef ZSTRING_VIEW_INSTRUMENT
+        source_location origin_;    // where the view was constructed
+        #endif
     };
 }
 
@@ -393,19 +871,19 @@ namespace std {
             #pragma GCC diagnostic ignored "-Wliteral-suffix"
             // [zstring.view.literals], suffix for basic_zstring_view literals
             constexpr zstring_view    operator""zsv(const char* str, size_t len) noexcept {
-                return basic_zstring_view(str, len);
+                return basic_zstring_view(str, len ZSTRING_VIEW_UNKNOWN_CALL_SITE);
             }
             constexpr u8zstring_view  operator""zsv(const char8_t* str, size_t len) noexcept {
-                return basic_zstring_view(str, len);
+                return basic_zstring_view(str, len ZSTRING_VIEW_UNKNOWN_CALL_SITE);
             }
             constexpr u16zstring_view operator""zsv(const char16_t* str, size_t len) noexcept {
-                return basic_zstring_view(str, len);
+                return basic_zstring_view(str, len ZSTRING_VIEW_UNKNOWN_CALL_SITE);
             }
             constexpr u32zstring_view operator""zsv(const char32_t* str, size_t len) noexcept {
-                return basic_zstring_view(str, len);
+                return basic_zstring_view(str, len ZSTRING_VIEW_UNKNOWN_CALL_SITE);
             }
             constexpr wzstring_view   operator""zsv(const wchar_t* str, size_t len) noexcept {
-                return basic_zstring_view(str, len);
+                return basic_zstring_view(str, len ZSTRING_VIEW_UNKNOWN_CALL_SITE);
             }
             #pragma GCC diagnostic pop
         }
@@ -0,0 +1,169 @@
+#ifndef ZSTRING_VIEW_INSTRUMENT_HPP
+#define ZSTRING_VIEW_INSTRUMENT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <source_location>
+#include <tuple>
+#include <vector>
+
+// NOTE: Not part of proposal. Counters behind ZSTRING_VIEW_INSTRUMENT, which zstring_view.hpp includes when the macro
+// is defined. Every basic_zstring_view records the call site that constructed it, and the costs that are easy to miss
+// in code review are counted against a call site:
+//
+// - length scans, and the bytes they read, by the const charT* constructor, against its caller
+// - conversions to basic_string_view, against the site that constructed the converted view
+// - out_of_range exceptions thrown by at(), against its caller
+//
+// Views from "..."zsv literals and default-constructed views have no call site, since a literal operator can't take a
+// source_location parameter: their conversions are counted against an unknown site, reported as <unknown>.
+//
+// A report sorted by bytes scanned is written to stderr at exit, and zstring_view_call_sites() returns the same data.
+// Counting takes a lock and a map lookup, so this is a diagnostic mode. The macro changes the layout of
+// basic_zstring_view and must be defined the same way in every translation unit.
+
+namespace std {
+    struct zstring_view_call_site {
+        const char* file;
+        uint_least32_t line;
+        uint_least32_t column;
+        const char* function;
+        uint64_t length_scans;
+        uint64_t bytes_scanned;
+        uint64_t conversions;
+        uint64_t at_throws;
+    };
+}
+
+namespace std::__zsv {
+    class __instrument_registry {
+    public:
+        enum class __event { length_scan, conversion, at_throw };
+
+        static __instrument_registry& instance() {
+            // Never destroyed, so views used by other static destructors can still be counted
+            static __instrument_registry* registry = [] {
+                auto* registry = new __instrument_registry;
+                atexit([] {
+                    __instrument_registry::instance().report(stderr);
+                });
+                return registry;
+            }();
+            return *registry;
+        }
+
+        void record(const source_location& site, __event event, uint64_t bytes = 0) noexcept {
+            try {
+                const lock_guard lock(mutex_);
+                zstring_view_call_site& counters = sites_.try_emplace(
+                    key{site.file_name(), site.line(), site.column(), site.function_name()},
+                    zstring_view_call_site{site.file_name(), site.line(), site.column(), site.function_name(), 0, 0, 0, 0}
+                ).first->second;
+                switch(event) {
+                    case __event::length_scan:
+                        counters.length_scans++;
+                        counters.bytes_scanned += bytes;
+                        break;
+                    case __event::conversion:
+                        counters.conversions++;
+                        break;
+                    case __event::at_throw:
+                        counters.at_throws++;
+                        break;
+                }
+            } catch(...) {
+                // Losing a count is better than failing the instrumented operation
+            }
+        }
+
+        // Sorted by bytes scanned, then by conversions
+        vector<zstring_view_call_site> sites() const {
+            vector<zstring_view_call_site> result;
+            {
+                const lock_guard lock(mutex_);
+                result.reserve(sites_.size());
+                for(const auto& [site, counters] : sites_) {
+                    result.push_back(counters);
+                }
+            }
+            std::stable_sort(result.begin(), result.end(), [](const auto& x, const auto& y) {
+                return tie(y.bytes_scanned, y.conversions) < tie(x.bytes_scanned, x.conversions);
+            });
+            return result;
+        }
+
+        void reset() noexcept {
+            const lock_guard lock(mutex_);
+            sites_.clear();
+        }
+
+        void report(FILE* out) const {
+            const vector<zstring_view_call_site> sites = this->sites();
+            if(sites.empty()) {
+                return;
+            }
+            fprintf(out, "zstring_view instrumentation: %zu call sites\n", sites.size());
+            fprintf(out, "%14s %14s %14s %12s  %s\n", "length scans", "bytes scanned", "conversions", "at() throws", "call site");
+            for(const auto& site : sites) {
+                fprintf(
+                    out,
+                    "%14llu %14llu %14llu %12llu  %s:%u:%u (%s)\n",
+                    static_cast<unsigned long long>(site.length_scans),
+                    static_cast<unsigned long long>(site.bytes_scanned),
+                    static_cast<unsigned long long>(site.conversions),
+                    static_cast<unsigned long long>(site.at_throws),
+                    site.file[0] ? site.file : "<unknown>",
+                    static_cast<unsigned>(site.line),
+                    static_cast<unsigned>(site.column),
+                    site.function
+                );
+            }
+        }
+
+    private:
+        // The same call site can come with different string pointers from different translation units
+        struct key {
+            const char* file;
+            uint_least32_t line;
+            uint_least32_t column;
+            const char* function;
+
+            bool operator<(const key& other) const noexcept {
+                if(line != other.line || column != other.column) {
+                    return tie(line, column) < tie(other.line, other.column);
+                }
+                if(const int order = strcmp(file, other.file)) {
+                    return order < 0;
+                }
+                return strcmp(function, other.function) < 0;
+            }
+        };
+
+        __instrument_registry() = default;
+
+        mutable mutex mutex_;
+        map<key, zstring_view_call_site> sites_;
+    };
+}
+
+namespace std {
+    // The counters recorded so far, sorted by bytes scanned and then by conversions
+    inline vector<zstring_view_call_site> zstring_view_call_sites() {
+        return __zsv::__instrument_registry::instance().sites();
+    }
+
+    inline void zstring_view_report(FILE* out = stderr) {
+        __zsv::__instrument_registry::instance().report(out);
+    }
+
+    inline void zstring_view_reset_counters() noexcept {
+        __zsv::__instrument_registry::instance().reset();
+    }
+}
+
+#endif
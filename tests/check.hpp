@@ -0,0 +1,44 @@
+#ifndef ZSTRING_VIEW_CHECK_HPP
+#define ZSTRING_VIEW_CHECK_HPP
+
+#include <cstdio>
+#include <exception>
+
+// A minimal harness for the test programs: CHECK records a failure with its location and carries on, so one run
+// reports every broken expectation, and main returns check::result().
+
+namespace check {
+    inline int failures = 0;
+
+    inline void fail(const char* expression, const char* file, int line) {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+        failures++;
+    }
+
+    // Exit status for main
+    inline int result() {
+        if(failures != 0) {
+            std::fprintf(stderr, "%d check%s failed\n", failures, failures == 1 ? "" : "s");
+            return 1;
+        }
+        return 0;
+    }
+}
+
+#define CHECK(...) ((__VA_ARGS__) ? void() : check::fail(#__VA_ARGS__, __FILE__, __LINE__))
+
+// Checks that the statement throws an exception of the given type
+#define CHECK_THROWS(type, ...) \
+    do { \
+        bool threw = false; \
+        try { \
+            __VA_ARGS__; \
+        } catch(const type&) { \
+            threw = true; \
+        } catch(...) {} \
+        if(!threw) { \
+            check::fail("throws " #type ": " #__VA_ARGS__, __FILE__, __LINE__); \
+        } \
+    } while(false)
+
+#endif
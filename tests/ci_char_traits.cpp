@@ -0,0 +1,121 @@
+#include "check.hpp"
+
+#include <ci_char_traits.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+
+// Comparison, search and hashing fold ASCII letters only, and the word-at-a-time and vector paths agree with a byte
+// at a time
+
+namespace {
+    char fold(char c) {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    int compare(const std::string& x, const std::string& y) {
+        for(std::size_t i = 0; i < std::min(x.size(), y.size()); i++) {
+            const unsigned char a = static_cast<unsigned char>(fold(x[i])), b = static_cast<unsigned char>(fold(y[i]));
+            if(a != b) {
+                return a < b ? -1 : 1;
+            }
+        }
+        return x.size() < y.size() ? -1 : x.size() > y.size();
+    }
+
+    std::size_t hash(std::ci_zstring_view str) {
+        return std::hash<std::ci_zstring_view>{}(str);
+    }
+}
+
+static_assert(std::ci_zstring_view("HoSt") == "host");
+static_assert(std::is_same_v<decltype(std::ci_zstring_view() <=> std::ci_zstring_view()), std::weak_ordering>);
+static_assert((std::ci_zstring_view("HoSt") <=> "host") == std::weak_ordering::equivalent);
+static_assert((std::ci_zstring_view("Host") <=> "hosts") == std::weak_ordering::less);
+static_assert(std::hash<std::ci_zstring_view>{}("ABCDEFGHIJKLMNOPQRSTUVWXYZ[@`{") ==
+              std::hash<std::ci_zstring_view>{}("abcdefghijklmnopqrstuvwxyz[@`{"));
+
+int main() {
+    const std::ci_zstring_view name = "Content-Length";
+    CHECK(name == "content-length");
+    CHECK(name != "content-lengthx");
+    CHECK(name.starts_with("CONTENT"));
+    CHECK(name.find('l') == 8);
+    CHECK(name.find("LENGTH") == 8);
+    CHECK(hash(name) == hash("CONTENT-LENGTH"));
+    CHECK(hash(name) != hash("CONTENT-LENGTX"));
+    CHECK(hash("[") != hash("{"));
+    CHECK(std::format("{:>6}", std::ci_zstring_view("Host")) == "  Host");
+
+    // Each byte value in each position of a word folds like it does alone
+    for(int b = 0; b < 256; b++) {
+        for(int pos = 0; pos < 8; pos++) {
+            const std::uint64_t word = 0x4141414141414141ull ^ (std::uint64_t(0x41 ^ b) << (8 * pos));
+            const std::uint64_t folded = std::__zsv::__ci_fold_word(word);
+            CHECK(((folded >> (8 * pos)) & 0xff) == static_cast<unsigned char>(std::__zsv::__ci_fold(static_cast<char>(b))));
+            CHECK(((folded >> (8 * ((pos + 1) % 8))) & 0xff) == 'a');
+        }
+    }
+
+    std::mt19937 rng(5);
+    const char alphabet[] = "aAbBzZ@[`{\x80\xc3\xe9-0";
+    const std::size_t letters = sizeof(alphabet) - 1;
+    for(int i = 0; i < 20000; i++) {
+        const std::size_t n = rng() % 80;
+        std::string x(n, ' ');
+        for(char& c : x) {
+            c = alphabet[rng() % letters];
+        }
+        std::string y = x;
+        for(char& c : y) {
+            if(rng() % 3 == 0) {
+                c = c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : fold(c);
+            }
+        }
+        if(n != 0 && rng() % 2 != 0) {
+            y[rng() % n] = alphabet[rng() % letters];
+        }
+        if(rng() % 4 == 0) {
+            y.resize(rng() % (n + 1));
+        }
+        const std::ci_zstring_view cx(x.c_str(), x.size()), cy(y.c_str(), y.size());
+        const int result = cx.compare(cy), expected = compare(x, y);
+        CHECK((result < 0) == (expected < 0));
+        CHECK((result > 0) == (expected > 0));
+        if(result == 0) {
+            CHECK(hash(cx) == hash(cy));
+        }
+        const char c = alphabet[rng() % letters];
+        std::size_t expected_pos = std::string::npos;
+        for(std::size_t j = 0; j < n; j++) {
+            if(fold(x[j]) == fold(c)) {
+                expected_pos = j;
+                break;
+            }
+        }
+        CHECK(cx.find(c) == expected_pos);
+#ifdef ZSTRING_VIEW_X86_SIMD
+        const std::size_t common = std::min(x.size(), y.size());
+        const std::size_t mismatch = std::__zsv::__ci_mismatch_sse2(x.data(), y.data(), common);
+        CHECK(mismatch == common || fold(x[mismatch]) != fold(y[mismatch]));
+        CHECK(std::__zsv::__ci_find_sse2(x.data(), n, fold(c)) == (expected_pos == std::string::npos ? n : expected_pos));
+        if(std::__zsv::__has_avx2) {
+            CHECK(std::__zsv::__ci_mismatch_avx2(x.data(), y.data(), common) == mismatch);
+            CHECK(std::__zsv::__ci_find_avx2(x.data(), n, fold(c)) == std::__zsv::__ci_find_sse2(x.data(), n, fold(c)));
+        }
+#endif
+    }
+
+    const std::unordered_set<std::ci_zstring_view> headers{"Host", "Accept"};
+    CHECK(headers.contains("HOST"));
+    CHECK(headers.contains("accept"));
+    CHECK(!headers.contains("hosts"));
+    return check::result();
+}
@@ -0,0 +1,66 @@
+#include "check.hpp"
+
+#include <format_to_z.hpp>
+
+#include <string>
+#include <string_view>
+
+// Output is terminated in each kind of storage, truncated only in a fixed span, and identical to std::format
+
+using namespace std::literals;
+
+int main() {
+    char buffer[8];
+    const auto fits = std::format_to_z(buffer, "{}-{}", 12, "ab");
+    CHECK(fits.str == "12-ab"sv);
+    CHECK(!fits.truncated);
+    CHECK(fits.size == 5);
+    CHECK(fits.str.c_str() == buffer);
+
+    const auto truncated = std::format_to_z(buffer, "{:>10}", 1);
+    CHECK(truncated.truncated);
+    CHECK(truncated.size == 10);
+    CHECK(truncated.str == "       "sv);
+    CHECK(buffer[7] == '\0');
+
+    wchar_t wide[16];
+    CHECK(std::format_to_z(wide, L"{}", 42).str == L"42"sv);
+
+    std::basic_zformat_buffer<char, 16> small;
+    CHECK(std::format_to_z(small, "{}", "short") == "short"sv);
+    const std::string long_string(100, 'y');
+    const std::zstring_view grown = std::format_to_z(small, "<{}>", long_string);
+    CHECK(grown == "<" + long_string + ">");
+    CHECK(grown.c_str()[grown.size()] == '\0');
+    CHECK(small.view() == grown);
+    CHECK(std::format_to_z(small, "{}", 7) == "7"sv);
+
+    std::zstring_arena arena(64);
+    const std::zstring_view first = std::format_to_z(arena, "{}:{}", "host", 80);
+    CHECK(first == "host:80"sv);
+    const std::string big(1000, 'z');
+    const std::zstring_view second = std::format_to_z(arena, "[{}]", big);
+    CHECK(second == "[" + big + "]");
+    CHECK(second.c_str()[second.size()] == '\0');
+    CHECK(first == "host:80"sv);
+
+    std::zstring_arena deduplicating(64, true);
+    const std::zstring_view once = std::format_to_z(deduplicating, "{}", big);
+    const std::size_t capacity = deduplicating.capacity();
+    for(int i = 0; i < 10; i++) {
+        CHECK(std::format_to_z(deduplicating, "{}", big).data() == once.data());
+    }
+    // Output that is already stored doesn't take arena storage again
+    CHECK(deduplicating.capacity() == capacity);
+    std::wzstring_arena wide_arena(16, true);
+    const std::wstring wide_big(300, L'w');
+    CHECK(std::format_to_z(wide_arena, L"{}", wide_big) == wide_big);
+    CHECK(std::format_to_z(wide_arena, L"{}", wide_big).data() == std::format_to_z(wide_arena, L"{}", wide_big).data());
+    CHECK(std::format_to_z(deduplicating, "{}{}", "a", 1).data() == std::format_to_z(deduplicating, "a1").data());
+
+    // Output that is formatted twice reads rvalue arguments twice
+    CHECK(std::format_to_z(small, "{}", std::string(100, 'r')) == std::string(100, 'r'));
+    CHECK(std::format_to_z(arena, "{}", std::string(1000, 'r')) == std::string(1000, 'r'));
+    CHECK(std::format_to_z(deduplicating, "{}", std::string(1000, 'z')).data() == once.data());
+    return check::result();
+}
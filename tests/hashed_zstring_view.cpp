@@ -0,0 +1,48 @@
+#include "check.hpp"
+
+#include <hashed_zstring_view.hpp>
+#include <ci_char_traits.hpp>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+// The cached hash agrees with hashing the string on the fly and with traits' equality, so containers keyed by hashed
+// views can be probed with any string type
+
+using namespace std::literals;
+
+static_assert("abc"hzsv.size() == 3);
+static_assert("abc"hzsv.hash() == std::hashed_zstring_view(std::zstring_view("abc")).hash());
+
+int main() {
+    const std::hashed_zstring_view literal = "hello"hzsv;
+    const std::string owner = "hello";
+    const std::hashed_zstring_view runtime = owner;
+    CHECK(literal.hash() == runtime.hash());
+    CHECK(literal == runtime);
+    CHECK(literal == "hello"zsv);
+    CHECK("hello"zsv == literal);
+    CHECK(literal != "help"hzsv);
+    CHECK(literal.c_str()[literal.size()] == '\0');
+    CHECK(u"wide"hzsv.hash() == std::u16hashed_zstring_view(u"wide").hash());
+
+    std::unordered_set<std::hashed_zstring_view, std::hash<std::hashed_zstring_view>, std::equal_to<>> set;
+    set.insert("abc"hzsv);
+    set.insert("def"hzsv);
+    CHECK(set.contains("abc"sv));
+    CHECK(set.contains(std::string("def")));
+    CHECK(!set.contains("abd"sv));
+    // With case-insensitive traits, strings that differ in case are equal and hash equal
+    using ci_hashed_zstring_view = std::basic_hashed_zstring_view<char, std::ci_char_traits>;
+    const ci_hashed_zstring_view lower("host"), upper("HoST");
+    CHECK(lower == upper);
+    CHECK(lower.hash() == upper.hash());
+    CHECK(lower != ci_hashed_zstring_view("hosts"));
+    std::unordered_set<ci_hashed_zstring_view, std::hash<ci_hashed_zstring_view>, std::equal_to<>> headers{"Host", "Accept"};
+    CHECK(headers.contains(ci_hashed_zstring_view("HOST")));
+    CHECK(headers.contains(std::ci_string_view("accept")));
+    CHECK(!headers.contains(std::ci_string_view("hosts")));
+    return check::result();
+}
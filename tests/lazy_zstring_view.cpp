@@ -0,0 +1,102 @@
+#include "check.hpp"
+
+#include <lazy_zstring_view.hpp>
+
+#include <format>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+// Every operation agrees with basic_string_view whether or not the length has been computed yet
+
+using namespace std::literals;
+
+namespace {
+    template<class charT>
+    void compare_with_string_view() {
+        std::mt19937 rng(1);
+        const auto random_string = [&] {
+            std::basic_string<charT> str(rng() % 6, charT());
+            for(charT& c : str) {
+                c = static_cast<charT>('a' + rng() % 3);
+            }
+            return str;
+        };
+        const auto sign = [](auto x) { return (x > 0) - (x < 0); };
+        for(int i = 0; i < 20000; i++) {
+            const std::basic_string<charT> a = random_string(), b = random_string();
+            const std::basic_string_view<charT> av = a, bv = b;
+            const charT c = static_cast<charT>('a' + rng() % 4);
+            // Fresh views so that each check starts with an unknown length
+            using lazy = std::basic_lazy_zstring_view<charT>;
+            CHECK(sign(lazy(a.c_str()).compare(bv)) == sign(av.compare(bv)));
+            CHECK(sign(lazy(a.c_str()).compare(lazy(b.c_str()))) == sign(av.compare(bv)));
+            CHECK((lazy(a.c_str()) == lazy(b.c_str())) == (av == bv));
+            CHECK((lazy(a.c_str()) == bv) == (av == bv));
+            CHECK((lazy(a.c_str()) <=> bv) == (av <=> bv));
+            CHECK(lazy(a.c_str()).starts_with(bv) == av.starts_with(bv));
+            CHECK(lazy(a.c_str()).starts_with(c) == av.starts_with(c));
+            CHECK(lazy(a.c_str()).find(c) == av.find(c));
+            CHECK(lazy(a.c_str()).find(c, 1) == av.find(c, 1));
+            CHECK(lazy(a.c_str()).contains(c) == av.contains(c));
+
+            const lazy la(a.c_str());
+            CHECK(la.empty() == av.empty());
+            CHECK(!la.size_known());
+            CHECK(la.size() == av.size());
+            CHECK(la.size_known());
+            CHECK(la.view() == av);
+            CHECK(la.starts_with(c) == av.starts_with(c));
+            CHECK(la.find(c, 1) == av.find(c, 1));
+        }
+    }
+}
+
+int main() {
+    compare_with_string_view<char>();
+    compare_with_string_view<char8_t>();
+    compare_with_string_view<char16_t>();
+    compare_with_string_view<char32_t>();
+    compare_with_string_view<wchar_t>();
+
+    const std::lazy_zstring_view empty;
+    CHECK(empty.empty());
+    CHECK(empty.size_known());
+    CHECK(empty.size() == 0);
+
+    const std::lazy_zstring_view hi("hi");
+    const std::zstring_view z = hi;
+    const std::string_view s = hi;
+    CHECK(z == s);
+    CHECK(std::format("{:>4}", hi) == "  hi");
+    CHECK(!hi.starts_with('\0'));
+    CHECK(std::lazy_zstring_view(std::string("known")).size_known());
+
+    // With its size known a view can hold null characters, and every operation sees them the way view() does
+    const std::string embedded("\0ab", 3);
+    const std::lazy_zstring_view sized{std::zstring_view(embedded)};
+    CHECK(sized.size_known());
+    CHECK(!sized.empty());
+    CHECK(sized.starts_with('\0'));
+    CHECK(sized.starts_with(std::string_view("\0a", 2)));
+    CHECK(!sized.starts_with('a'));
+    CHECK(sized.find('\0') == 0);
+    CHECK(sized.view().starts_with('\0') == sized.starts_with('\0'));
+    // Without it the view ends at the first null character, before or after the length is computed
+    std::lazy_zstring_view scanned(embedded.c_str());
+    CHECK(scanned.empty());
+    CHECK(!scanned.starts_with('\0'));
+    CHECK(!scanned.starts_with(std::string_view("\0a", 2)));
+    CHECK(scanned.find('\0') == scanned.npos);
+    CHECK(scanned.size() == 0);
+    CHECK(scanned.empty());
+    CHECK(!scanned.starts_with('\0'));
+    CHECK(scanned.find('\0') == scanned.npos);
+    CHECK(!std::lazy_zstring_view(std::zstring_view()).starts_with('\0'));
+
+    const std::unordered_set<std::lazy_zstring_view> set{"a", "b"};
+    CHECK(set.contains("a"));
+    CHECK(!set.contains("c"));
+    return check::result();
+}
@@ -0,0 +1,95 @@
+#include "check.hpp"
+
+#include <mapped_zfile.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include <unistd.h>
+
+// Files of every size around a page boundary map with a terminator after the last byte, files that report a size of 0
+// are read, growing the file doesn't reach the mapping, and lines() splits a private copy of the pages once
+
+using namespace std::literals;
+
+namespace {
+    std::string write_temporary(const std::string& contents) {
+        char path[] = "/tmp/zstring_view_test_XXXXXX";
+        const int fd = ::mkstemp(path);
+        CHECK(fd != -1);
+        CHECK(::write(fd, contents.data(), contents.size()) == static_cast<ssize_t>(contents.size()));
+        ::close(fd);
+        return path;
+    }
+}
+
+int main() {
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    for(const std::size_t size : {std::size_t(0), std::size_t(1), page - 1, page, page + 1, 2 * page}) {
+        std::string contents(size, 'x');
+        for(std::size_t i = 0; i < size; i++) {
+            contents[i] = static_cast<char>('a' + i % 26);
+        }
+        const std::string path = write_temporary(contents);
+        {
+            const std::mapped_zfile file(std::zstring_view(path), std::mapped_zfile::access_hint::random);
+            CHECK(file.size() == size);
+            CHECK(file.empty() == (size == 0));
+            CHECK(file.view() == contents);
+            CHECK(file.view().c_str()[size] == '\0');
+        }
+        ::unlink(path.c_str());
+    }
+
+    // Appending to the file after it is mapped doesn't overwrite the terminator
+    {
+        const std::string path = write_temporary("short");
+        const std::mapped_zfile file{std::zstring_view(path)};
+        std::FILE* out = std::fopen(path.c_str(), "a");
+        CHECK(out != nullptr);
+        CHECK(std::fputs(" and then some", out) >= 0);
+        std::fclose(out);
+        CHECK(file.view() == "short");
+        CHECK(file.view().c_str()[5] == '\0');
+        CHECK(std::string_view(file.view().c_str()) == "short");
+        ::unlink(path.c_str());
+    }
+
+    const std::string path = write_temporary("one\n\nthree\n");
+    {
+        std::mapped_zfile file{std::zstring_view(path)};
+        std::vector<std::string> lines;
+        for(std::zstring_view line : file.lines()) {
+            lines.emplace_back(line);
+        }
+        CHECK((lines == std::vector<std::string>{"one", "", "three"}));
+        CHECK(file.view() == "one\0\0three\0"sv);
+        // The newlines are gone, so the lines can't be split again
+        CHECK_THROWS(std::logic_error, file.lines());
+
+        std::mapped_zfile moved = std::move(file);
+        CHECK(file.view().empty());
+        CHECK(moved.size() == 11);
+    }
+    ::unlink(path.c_str());
+
+    // /proc files report a size of 0 and are read instead of mapped
+    {
+        std::mapped_zfile status("/proc/self/status"zsv);
+        CHECK(!status.empty());
+        CHECK(status.view().starts_with("Name:"));
+        CHECK(status.view().c_str()[status.size()] == '\0');
+        std::size_t count = 0;
+        for(std::zstring_view line : status.lines()) {
+            CHECK(line.find('\n') == line.npos);
+            count++;
+        }
+        CHECK(count > 1);
+    }
+
+    CHECK_THROWS(std::system_error, std::mapped_zfile("/nonexistent/zstring_view"zsv));
+    return check::result();
+}
@@ -0,0 +1,127 @@
+#include "check.hpp"
+
+#include <zsort.hpp>
+#include <ci_char_traits.hpp>
+
+#include <algorithm>
+#include <execution>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// zsort agrees with std::sort for every character type, with shared prefixes and embedded nulls, the LCPs match the
+// sorted neighbours, long shared prefixes don't exhaust the stack, and zunique agrees with std::unique
+
+namespace {
+    template<class View>
+    std::size_t common_prefix(const View& x, const View& y) {
+        std::size_t k = 0;
+        while(k < std::min(x.size(), y.size()) && View::traits_type::eq(x[k], y[k])) {
+            k++;
+        }
+        return k;
+    }
+
+    template<class charT, class traits = std::char_traits<charT>, class Policy = int>
+    void compare_with_sort(std::size_t n, int alphabet, std::size_t max_size, unsigned seed, bool nulls, Policy policy = 0) {
+        std::mt19937 rng(seed);
+        const charT letters[] = {
+            charT('a'), charT('b'), charT('A'), charT(0x7f), static_cast<charT>(-1), static_cast<charT>(0xe9),
+            charT(nulls ? 0 : 'z'), charT('c')
+        };
+        std::vector<std::basic_string<charT, traits>> strings(n);
+        for(std::size_t i = 0; i < n; i++) {
+            const std::size_t size = rng() % (max_size + 1);
+            // Often a prefix of the previous string
+            if(i != 0 && rng() % 2 != 0) {
+                strings[i] = strings[i - 1].substr(0, rng() % (strings[i - 1].size() + 1));
+            }
+            while(strings[i].size() < size) {
+                strings[i].push_back(letters[rng() % alphabet]);
+            }
+        }
+        std::vector<std::basic_zstring_view<charT, traits>> views;
+        for(const auto& str : strings) {
+            views.emplace_back(str.c_str(), str.size());
+        }
+        auto expected = views;
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<std::size_t> lcp(n, 12345);
+        if constexpr(std::is_same_v<Policy, int>) {
+            std::zsort(views, lcp);
+        } else {
+            std::zsort(policy, views, lcp);
+        }
+        CHECK(std::equal(views.begin(), views.end(), expected.begin(), expected.end()));
+        CHECK(n == 0 || lcp[0] == 0);
+        for(std::size_t i = 1; i < n; i++) {
+            if(lcp[i] != common_prefix(views[i - 1], views[i])) {
+                CHECK(lcp[i] == common_prefix(views[i - 1], views[i]));
+                break;
+            }
+        }
+
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+        const std::size_t unique = std::zunique(views, lcp);
+        CHECK(unique == expected.size());
+        CHECK(std::equal(views.begin(), views.begin() + unique, expected.begin(), expected.end()));
+        for(std::size_t i = 1; i < unique; i++) {
+            if(lcp[i] != common_prefix(views[i - 1], views[i])) {
+                CHECK(lcp[i] == common_prefix(views[i - 1], views[i]));
+                break;
+            }
+        }
+    }
+}
+
+int main() {
+    for(unsigned seed = 0; seed < 60; seed++) {
+        const std::size_t n = seed % 7 == 0 ? seed : 50 + seed * 37;
+        compare_with_sort<char>(n, 3, 20, seed, false);
+        compare_with_sort<char>(n, 7, 30, seed, true);
+        compare_with_sort<char>(n, 8, 12, seed, true);
+        compare_with_sort<char8_t>(n, 4, 40, seed, false);
+        compare_with_sort<char16_t>(n, 8, 20, seed, true);
+        compare_with_sort<char32_t>(n, 8, 20, seed, true);
+        compare_with_sort<wchar_t>(n, 8, 20, seed, true);
+        compare_with_sort<char, std::ci_char_traits>(n, 4, 10, seed, false);
+    }
+    compare_with_sort<char>(300000, 3, 24, 99, false, std::execution::par);
+    compare_with_sort<char>(200000, 8, 16, 98, true, std::execution::par);
+    compare_with_sort<wchar_t>(100000, 8, 16, 97, true, std::execution::seq);
+
+    // A long shared prefix takes a pass per key, not a stack frame
+    const std::string prefix(2 << 20, 'p');
+    std::vector<std::string> long_strings;
+    for(int i = 0; i < 40; i++) {
+        long_strings.push_back(prefix + std::to_string(i * 7 % 40));
+    }
+    long_strings.push_back(prefix);
+    std::vector<std::zstring_view> long_views(long_strings.begin(), long_strings.end());
+    std::vector<std::size_t> long_lcp(long_views.size());
+    std::zsort(long_views, long_lcp);
+    CHECK(std::is_sorted(long_views.begin(), long_views.end()));
+    CHECK(long_views[0] == prefix);
+    CHECK(long_lcp[1] == prefix.size());
+    for(std::size_t i = 1; i < long_views.size(); i++) {
+        if(long_lcp[i] != common_prefix(long_views[i - 1], long_views[i])) {
+            CHECK(long_lcp[i] == common_prefix(long_views[i - 1], long_views[i]));
+            break;
+        }
+    }
+
+    std::vector<std::zstring_view> same(1000, "same");
+    std::zsort(same);
+    CHECK(std::zunique(same) == 1);
+    std::vector<std::zstring_view> empty;
+    std::vector<std::size_t> lcp;
+    std::zsort(empty);
+    std::zsort(empty, lcp);
+    std::zstring_view array[] = {"b", "a", ""};
+    std::zsort(array);
+    CHECK(array[0] == "");
+    CHECK(array[1] == "a");
+    return check::result();
+}
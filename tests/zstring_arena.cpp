@@ -0,0 +1,82 @@
+#include "check.hpp"
+
+#include <zstring_arena.hpp>
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Copies are terminated and stable across chunk boundaries, deduplication shares storage and reset reuses it
+
+using namespace std::literals;
+
+int main() {
+    std::zstring_arena arena(64);
+    std::vector<std::string> strings;
+    std::vector<std::zstring_view> views;
+    for(int i = 0; i < 200; i++) {
+        strings.push_back(std::string(i % 60, static_cast<char>('a' + i % 26)));
+        views.push_back(arena.store(strings.back()));
+    }
+    for(std::size_t i = 0; i < views.size(); i++) {
+        CHECK(views[i] == strings[i]);
+        CHECK(views[i].c_str()[views[i].size()] == '\0');
+    }
+    CHECK(arena.concat("ab"sv, std::string("cd"), "ef"zsv) == "abcdef");
+    const std::size_t capacity = arena.capacity();
+    arena.reset();
+    for(int i = 0; i < 200; i++) {
+        arena.store(strings[i]);
+    }
+    CHECK(arena.capacity() == capacity);
+
+    // Strings longer than a chunk get chunks of their own, which are reused after a reset
+    std::zstring_arena oversized(64);
+    const std::string large(100, 'x'), larger(300, 'y');
+    std::size_t warm = 0;
+    for(int cycle = 0; cycle < 10; cycle++) {
+        oversized.reset();
+        CHECK(oversized.store("a") == "a");
+        CHECK(oversized.store(large) == large);
+        CHECK(oversized.store(std::string(40, 'b')) == std::string(40, 'b'));
+        CHECK(oversized.store(larger) == larger);
+        CHECK(oversized.store(large) == large);
+        if(cycle == 0) {
+            warm = oversized.capacity();
+        }
+        CHECK(oversized.capacity() == warm);
+    }
+
+    std::zstring_arena deduplicating(64, true);
+    const std::zstring_view first = deduplicating.store("hello");
+    CHECK(deduplicating.store("hello").data() == first.data());
+    CHECK(deduplicating.concat("hel"sv, "lo"sv).data() == first.data());
+    CHECK(deduplicating.store("hellO").data() != first.data());
+
+    // Duplicate concatenations don't keep storage, whatever their size
+    const std::size_t before = deduplicating.capacity();
+    const std::string half(100, 'h');
+    const std::zstring_view joined = deduplicating.concat(half, half);
+    CHECK(joined == half + half);
+    const std::size_t after = deduplicating.capacity();
+    CHECK(after > before);
+    for(int i = 0; i < 10; i++) {
+        CHECK(deduplicating.concat(half, std::string_view(half)).data() == joined.data());
+        CHECK(deduplicating.concat("hel"sv, "lo"sv).data() == first.data());
+    }
+    CHECK(deduplicating.capacity() == after);
+
+    static_assert(std::is_move_constructible_v<std::zstring_arena>);
+    static_assert(!std::is_move_assignable_v<std::zstring_arena>);
+    std::zstring_arena moved(std::move(deduplicating));
+    CHECK(moved.store("hello").data() == first.data());
+
+    std::u16zstring_arena wide;
+    CHECK(wide.store(u"wide"sv) == u"wide");
+
+    arena.release();
+    CHECK(arena.capacity() == 0);
+    return check::result();
+}
@@ -0,0 +1,44 @@
+#include "check.hpp"
+
+#include <zstring_buffer.hpp>
+#include <hashed_zstring_view.hpp>
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Strings that are already terminated are referenced, others are copied inline or onto the heap
+
+using namespace std::literals;
+
+static_assert(!std::is_move_constructible_v<std::zstring_buffer>);
+
+int main() {
+    const std::string_view sentence = "hello world";
+    const auto prefix = std::c_str_of(sentence.substr(0, 5));
+    CHECK(prefix.view() == "hello"sv);
+    CHECK(prefix.copied());
+    CHECK(std::strlen(prefix.c_str()) == 5);
+
+    const std::string big(1000, 'x');
+    const auto long_copy = std::c_str_of(std::string_view(big));
+    CHECK(long_copy.size() == 1000);
+    CHECK(long_copy.copied());
+    CHECK(long_copy.c_str()[1000] == '\0');
+
+    const auto from_string = std::c_str_of(big);
+    CHECK(!from_string.copied());
+    CHECK(from_string.c_str() == big.c_str());
+    CHECK(!std::c_str_of("literal"zsv).copied());
+    CHECK(!std::c_str_of("pointer").copied());
+    CHECK(!std::zstring_buffer("hashed"hzsv).copied());
+
+    // Exactly at and just under the inline capacity
+    const auto full = std::c_str_of<4>(u"abcd"sv);
+    CHECK(full.copied());
+    CHECK(full.view() == u"abcd"sv);
+    CHECK(std::c_str_of<4>(u"abc"sv).view() == u"abc"sv);
+    CHECK(std::wzstring_buffer(L"abc"sv).view() == L"abc"sv);
+    return check::result();
+}
@@ -0,0 +1,50 @@
+#include "check.hpp"
+
+#include <zstring_hash.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Heterogeneous lookup in containers keyed by std::string, and wyhash against its reference vectors
+
+using namespace std::literals;
+
+int main() {
+    std::unordered_map<std::string, int, std::zstring_hash, std::zstring_equal> map;
+    map["hello"] = 1;
+    map["world"] = 2;
+    CHECK(map.find("hello"zsv)->second == 1);
+    CHECK(map.find("world"sv)->second == 2);
+    CHECK(map.find("hello") != map.end());
+    CHECK(map.find("hellO"zsv) == map.end());
+
+    std::unordered_map<std::string, int, std::zstring_fast_hash, std::zstring_equal> fast{{"key", 3}};
+    CHECK(fast.find("key"zsv)->second == 3);
+    CHECK(std::zstring_fast_hash{}("key"zsv) == std::zstring_fast_hash{}(std::string("key")));
+
+    // Every length up to and past the 48-byte block exercises each branch of the hash
+    std::string prefix;
+    for(int n = 0; n < 120; n++) {
+        const std::string copy = prefix;
+        CHECK(std::zstring_wyhash::hash(std::string_view(prefix)) == std::zstring_wyhash::hash(std::string_view(copy)));
+        prefix.push_back(static_cast<char>('a' + n % 26));
+        CHECK(std::zstring_wyhash::hash(std::string_view(prefix)) != std::zstring_wyhash::hash(std::string_view(copy)));
+    }
+    // The reference vectors of wyhash final 4, each hashed with its index as the seed
+    const std::string_view messages[] = {
+        "", "a", "abc", "message digest", "abcdefghijklmnopqrstuvwxyz",
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+        "12345678901234567890123456789012345678901234567890123456789012345678901234567890",
+    };
+    const std::uint64_t expected[] = {
+        0x93228a4de0eec5a2, 0xc5bac3db178713c4, 0xa97f2f7b1d9b3314, 0x786d1f1df3801df4, 0xdca5a8138ad37c87,
+        0xb9e734f117cfaf70, 0x6cc5eab49a92d617,
+    };
+    for(std::uint64_t i = 0; i < std::size(messages); i++) {
+        CHECK(std::zstring_wyhash::hash(messages[i], i) == expected[i]);
+    }
+    return check::result();
+}
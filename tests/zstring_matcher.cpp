@@ -0,0 +1,100 @@
+#include "check.hpp"
+
+#include <zstring_matcher.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The automaton reports the same matches as trying every pattern at every position, up to the first null
+
+namespace {
+    std::vector<std::zstring_match> naive_find_all(const std::vector<std::string>& patterns, const std::string& haystack) {
+        const std::string_view text(haystack.c_str());
+        std::vector<std::zstring_match> matches;
+        for(std::size_t end = 0; end <= text.size(); end++) {
+            std::vector<std::zstring_match> here;
+            for(std::size_t p = 0; p < patterns.size(); p++) {
+                const std::string& pattern = patterns[p];
+                const bool first = std::find(patterns.begin(), patterns.end(), pattern) == patterns.begin() + p;
+                if(first && pattern.size() <= end && text.substr(end - pattern.size(), pattern.size()) == pattern) {
+                    here.push_back({p, end - pattern.size(), pattern.size()});
+                }
+            }
+            std::stable_sort(here.begin(), here.end(), [](const auto& x, const auto& y) { return x.size > y.size; });
+            matches.insert(matches.end(), here.begin(), here.end());
+        }
+        return matches;
+    }
+}
+
+int main() {
+    const std::zstring_matcher routes{"/api/", "/api/v2/", "/static/", "/"};
+    CHECK(routes.longest_prefix("/api/v2/users")->pattern == 1);
+    CHECK(routes.longest_prefix("/api/v1/users")->pattern == 0);
+    CHECK(routes.longest_prefix("/index")->pattern == 3);
+    CHECK(routes.longest_prefix("/api/v2/")->size == 8);
+    CHECK(!routes.longest_prefix("index"));
+
+    const std::zstring_matcher alerts{"ERROR", "FATAL", "panic:"};
+    CHECK(alerts.contains_any("x ERROR y"));
+    CHECK(!alerts.contains_any("x ERRO y"));
+    CHECK(!alerts.contains_any(""));
+    CHECK(!alerts.contains_any(std::zstring_view(std::string("aaa\0ERROR", 9))));
+
+    const std::zstring_matcher words{"he", "she", "his", "hers"};
+    CHECK((words.find_all("ushers") == std::vector<std::zstring_match>{{1, 1, 3}, {0, 2, 2}, {3, 2, 4}}));
+
+    const std::zstring_matcher empty{""};
+    CHECK(empty.contains_any(""));
+    CHECK(empty.find_all("ab").size() == 3);
+    CHECK(empty.longest_prefix("ab")->size == 0);
+    const std::zstring_matcher none{std::vector<std::string>{}};
+    CHECK(!none.contains_any("abc"));
+    CHECK(none.find_all("abc").empty());
+
+    const std::u8zstring_matcher accents{u8"é", u8"ü"};
+    CHECK(accents.contains_any(u8"abcü"));
+
+    CHECK_THROWS(std::invalid_argument, std::zstring_matcher(std::vector<std::string>{std::string("a\0b", 3)}));
+
+    std::mt19937 rng(1);
+    for(int i = 0; i < 2000; i++) {
+        const std::size_t alphabet = 2 + rng() % 4;
+        std::vector<std::string> patterns(1 + rng() % 12);
+        for(std::string& pattern : patterns) {
+            pattern.resize(rng() % 5);
+            for(char& c : pattern) {
+                c = "abcd\xff"[rng() % alphabet];
+            }
+        }
+        std::string haystack(rng() % 40, 'a');
+        for(char& c : haystack) {
+            c = std::string_view("abcd\xff\0", 6)[rng() % (alphabet + 1)];
+        }
+        const std::zstring_matcher matcher(patterns);
+        const std::vector<std::zstring_match> expected = naive_find_all(patterns, haystack);
+        CHECK(matcher.find_all(std::zstring_view(haystack)) == expected);
+        CHECK(matcher.contains_any(std::zstring_view(haystack)) == !expected.empty());
+        std::optional<std::zstring_match> prefix;
+        for(const auto& match : expected) {
+            if(match.position == 0 && (!prefix || match.size > prefix->size)) {
+                prefix = match;
+            }
+        }
+        CHECK(matcher.longest_prefix(std::zstring_view(haystack)) == prefix);
+    }
+
+    std::vector<std::string> every_byte;
+    for(int b = 1; b < 256; b++) {
+        every_byte.emplace_back(1, static_cast<char>(b));
+    }
+    const std::zstring_matcher bytes(every_byte);
+    CHECK(bytes.class_count() == 256);
+    CHECK(bytes.find_all("\x01\xff").size() == 2);
+    return check::result();
+}
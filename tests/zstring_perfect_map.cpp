@@ -0,0 +1,61 @@
+#include "check.hpp"
+
+#include <zstring_perfect_map.hpp>
+#include <ci_char_traits.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Lookups find every key and reject everything else, at compile time and for maps built at run time
+
+using namespace std::literals;
+
+constexpr auto methods = std::make_zstring_perfect_map<int>({
+    {"GET"zsv, 1}, {"POST"zsv, 2}, {"PUT"zsv, 3}, {"DELETE"zsv, 4}, {"HEAD"zsv, 5}
+});
+static_assert(*methods.find("POST"sv) == 2);
+static_assert(!methods.find("PATCH"sv));
+static_assert(!methods.find("GE"sv));
+static_assert(methods.at("HEAD"zsv) == 5);
+
+constexpr auto wide = std::make_zstring_perfect_map<int, char16_t>({{u"a"zsv, 1}, {u"b"zsv, 2}});
+static_assert(wide.contains(u"b"sv));
+static_assert(!wide.contains(u""sv));
+
+// Keys are hashed consistently with traits
+constexpr auto headers = std::make_zstring_perfect_map<int, char, std::ci_char_traits>({
+    {std::ci_zstring_view("Host"), 1}, {std::ci_zstring_view("Content-Length"), 2}, {std::ci_zstring_view("Accept"), 3}
+});
+static_assert(*headers.find("host") == 1);
+static_assert(*headers.find("CONTENT-length") == 2);
+static_assert(headers.at(std::ci_string_view("aCCEPT")) == 3);
+static_assert(!headers.contains("Hosts"));
+
+int main() {
+    std::vector<std::string> keys;
+    for(int i = 0; i < 300; i++) {
+        keys.push_back("key-" + std::to_string(i * 7919));
+    }
+    // Built at run time, the keys aren't known to the compiler
+    static std::pair<std::zstring_view, int> entries[300];
+    for(int i = 0; i < 300; i++) {
+        entries[i] = {std::zstring_view(keys[i]), i};
+    }
+    const auto map = std::make_zstring_perfect_map<int>(entries);
+    for(int i = 0; i < 300; i++) {
+        CHECK(map.find(keys[i].c_str()) && *map.find(keys[i].c_str()) == i);
+        CHECK(map.at(std::zstring_view(keys[i])) == i);
+    }
+    CHECK(!map.contains("key-1"sv));
+    CHECK(!map.contains(""sv));
+    CHECK_THROWS(std::out_of_range, (void)methods.at("x"));
+
+    const std::pair<std::zstring_view, int> duplicates[] = {{"a"zsv, 1}, {"a"zsv, 2}};
+    CHECK_THROWS(std::invalid_argument, std::make_zstring_perfect_map<int>(duplicates));
+    const std::pair<std::ci_zstring_view, int> ci_duplicates[] = {{"Host", 1}, {"HOST", 2}};
+    CHECK_THROWS(std::invalid_argument, std::make_zstring_perfect_map<int>(ci_duplicates));
+    return check::result();
+}
@@ -0,0 +1,66 @@
+#include "check.hpp"
+
+#include <zstring_posix.hpp>
+
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// The wrappers pass the views' terminated data straight through, and zstring_view_array builds argv/envp arrays
+// inline or on the heap
+
+using namespace std::literals;
+
+extern char** environ;
+
+namespace {
+    int wait_for(pid_t pid) {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+}
+
+int main() {
+    namespace px = zstring_posix;
+
+    CHECK(px::setenv("ZSTRING_VIEW_TEST"zsv, "value"zsv) == 0);
+    CHECK(px::getenv("ZSTRING_VIEW_TEST"zsv) == "value"zsv);
+    CHECK(px::setenv("ZSTRING_VIEW_TEST"zsv, "other"zsv, false) == 0);
+    CHECK(px::getenv("ZSTRING_VIEW_TEST"zsv) == "value"zsv);
+    CHECK(!px::getenv("ZSTRING_VIEW_TEST_UNSET"zsv));
+
+    struct stat st;
+    CHECK(px::stat("/tmp"zsv, &st) == 0);
+    CHECK(px::access("/tmp"zsv, R_OK) == 0);
+    const std::string path = "/tmp/zstring_view_test_posix_" + std::to_string(::getpid());
+    const int fd = px::open(std::zstring_view(path), O_CREAT | O_WRONLY | O_CLOEXEC, 0600);
+    CHECK(fd != -1);
+    ::close(fd);
+    CHECK(px::unlink(std::zstring_view(path)) == 0);
+    CHECK(px::unlink(std::zstring_view(path)) == -1);
+
+    std::vector<std::string> strings;
+    for(int i = 0; i < 40; i++) {
+        strings.push_back("arg" + std::to_string(i));
+    }
+    const std::vector<std::zstring_view> views(strings.begin(), strings.end());
+    const px::zstring_view_array many(views);
+    CHECK(many.size() == 40);
+    CHECK(many.data()[40] == nullptr);
+    CHECK(many[39] == "arg39"sv);
+    CHECK(many.data()[0] == strings[0].c_str());
+
+    pid_t pid;
+    const px::zstring_view_array argv{"/bin/sh"zsv, "-c"zsv, "test \"$X\" = y"zsv};
+    CHECK(px::posix_spawn(&pid, "/bin/sh"zsv, nullptr, nullptr, argv, px::zstring_view_array{"X=y"zsv}) == 0);
+    CHECK(wait_for(pid) == 0);
+    CHECK(px::posix_spawn(&pid, "/bin/sh"zsv, nullptr, nullptr, argv, px::zstring_view_array{"X=n"zsv}) == 0);
+    CHECK(wait_for(pid) == 1);
+    CHECK(px::posix_spawn(&pid, "/bin/sh"zsv, nullptr, nullptr, px::zstring_view_array{"sh"zsv, "-c"zsv, "exit 3"zsv}, environ) == 0);
+    CHECK(wait_for(pid) == 3);
+    return check::result();
+}
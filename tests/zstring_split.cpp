@@ -0,0 +1,50 @@
+#include "check.hpp"
+
+#include <zstring_split.hpp>
+
+#include <concepts>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Tokens are terminated in place, empty fields are kept but a trailing delimiter ends the input, and NUL-separated
+// blocks from a pointer stop at an empty entry
+
+using namespace std::literals;
+
+namespace {
+    template<class R>
+    std::vector<std::string> collect(R&& range) {
+        std::vector<std::string> tokens;
+        for(std::zstring_view token : range) {
+            CHECK(token.c_str()[token.size()] == '\0');
+            tokens.emplace_back(token);
+        }
+        return tokens;
+    }
+}
+
+static_assert(std::ranges::forward_range<std::ranges::zsplit_nul_view<char>>);
+static_assert(std::ranges::view<std::ranges::zsplit_view<char>>);
+static_assert(std::ranges::input_range<std::ranges::zsplit_view<char>>);
+static_assert(std::invocable<decltype(std::views::zsplit_nul), const std::string&>);
+static_assert(!std::invocable<decltype(std::views::zsplit_nul), std::string>);
+
+int main() {
+    std::string fields = ",a,,bb,";
+    CHECK((collect(fields | std::views::zsplit(',')) == std::vector<std::string>{"", "a", "", "bb"}));
+    CHECK(fields == std::string("\0a\0\0bb\0", 7));
+
+    std::string empty;
+    CHECK(collect(std::views::zsplit(empty, ',')).empty());
+
+    std::string words = "p q r";
+    CHECK((collect(std::views::zsplit(words, ' ') | std::views::take(2)) == std::vector<std::string>{"p", "q"}));
+
+    const std::string_view block("x\0\0yy\0", 6);
+    CHECK((collect(std::views::zsplit_nul(block)) == std::vector<std::string>{"x", "", "yy"}));
+    const char* environment = "A=1\0B=2\0\0";
+    CHECK((collect(std::views::zsplit_nul(environment)) == std::vector<std::string>{"A=1", "B=2"}));
+    return check::result();
+}
@@ -0,0 +1,146 @@
+#include "check.hpp"
+
+#include <zstring_table.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// Tables built from random strings, with shared tails and embedded nulls, return every string by id and by lookup,
+// malformed blobs are rejected when opened, and corrupt ones are caught by validate()
+
+namespace {
+    template<class charT>
+    void round_trip(unsigned seed) {
+        std::mt19937 rng(seed);
+        std::basic_zstring_table_builder<charT> builder;
+        std::vector<std::basic_string<charT>> strings;
+        const std::size_t n = rng() % 200;
+        std::size_t units = 0;
+        for(std::size_t i = 0; i < n; i++) {
+            std::basic_string<charT> str(rng() % 6, charT());
+            for(charT& c : str) {
+                c = static_cast<charT>("abc\0"[rng() % 4]);
+            }
+            if(!str.empty() && rng() % 2 != 0) {
+                str += charT(0x7f);
+            }
+            strings.push_back(str);
+            units += str.size() + 1;
+            CHECK(builder.add(str) == i);
+        }
+        const std::vector<std::byte> blob = builder.build();
+        CHECK(blob.size() <= 32 + 8 * n + 8 * (n * 3 / 2 + 1) + units * sizeof(charT));
+
+        const std::basic_zstring_table<charT> table{std::span<const std::byte>(blob)};
+        CHECK(table.size() == n);
+        CHECK(table.verify_checksum());
+        CHECK(table.validate());
+        for(std::size_t i = 0; i < n; i++) {
+            const auto str = table[i];
+            CHECK(std::basic_string_view<charT>(str) == strings[i]);
+            CHECK(str.c_str()[str.size()] == charT());
+            CHECK(table.find(strings[i]) == std::size_t(std::find(strings.begin(), strings.end(), strings[i]) - strings.begin()));
+        }
+        CHECK(table.find(std::basic_string<charT>(7, charT('z'))) == table.npos);
+    }
+}
+
+int main() {
+    std::zstring_table_builder builder;
+    for(const char* str : {"resize", "size", "ize", "main", "", "size", "x"}) {
+        builder.add(str);
+    }
+    const std::vector<std::byte> blob = builder.build();
+    // The strings are resize, main and x, the others are their tails
+    CHECK(blob.size() == 32 + 8 * 7 + 8 * 11 + 14);
+
+    const std::zstring_table table{std::span<const std::byte>(blob)};
+    CHECK(table[0] == "resize");
+    CHECK(table[1] == "size");
+    CHECK(table[4] == "");
+    CHECK(table[5] == "size");
+    CHECK(table.find("size") == 1);
+    CHECK(table.find("") == 4);
+    CHECK(table.find("siz") == table.npos);
+    CHECK(table.contains("x"));
+    CHECK(table.version() == 1);
+    CHECK_THROWS(std::out_of_range, (void)table.at(7));
+
+    std::vector<std::byte> flipped = blob;
+    flipped[50] ^= std::byte{1};
+    CHECK(!std::zstring_table{std::span<const std::byte>(flipped)}.verify_checksum());
+    CHECK_THROWS(std::invalid_argument, std::u16zstring_table{std::span<const std::byte>(blob)});
+    CHECK_THROWS(std::invalid_argument, std::zstring_table{std::span<const std::byte>(blob).first(blob.size() - 1)});
+    CHECK_THROWS(std::invalid_argument, std::zstring_table{std::span<const std::byte>(blob).first(10)});
+
+    // Hostile blobs open, since that only checks the header, but lookups terminate and validate() rejects them
+    {
+        std::zstring_table_builder one;
+        one.add("x");
+        const std::vector<std::byte> valid = one.build();
+        // Header, one index entry, then two slots of hash and id plus one
+        const std::size_t index = 32, slots = 40;
+        const auto patch = [&](std::size_t offset, std::uint32_t value) {
+            std::vector<std::byte> patched = valid;
+            std::memcpy(patched.data() + offset, &value, sizeof(value));
+            return patched;
+        };
+
+        std::vector<std::byte> full = patch(slots + 4, 1);
+        std::memcpy(full.data() + slots + 8 + 4, full.data() + slots + 4, 4);
+        const std::zstring_table no_empty_slot{std::span<const std::byte>(full)};
+        CHECK(no_empty_slot.find("q") == no_empty_slot.npos);
+        CHECK(no_empty_slot.find("x") == 0);
+
+        const std::vector<std::byte> far_offset = patch(index, 1000000);
+        CHECK(!std::zstring_table{std::span<const std::byte>(far_offset)}.validate());
+        const std::vector<std::byte> long_size = patch(index + 4, 2);
+        CHECK(!std::zstring_table{std::span<const std::byte>(long_size)}.validate());
+        const std::vector<std::byte> wrapping = patch(index, 0xffffffff);
+        CHECK(!std::zstring_table{std::span<const std::byte>(wrapping)}.validate());
+        // Still inside the string area but not followed by a terminator
+        const std::vector<std::byte> unterminated = patch(index + 4, 0);
+        CHECK(!std::zstring_table{std::span<const std::byte>(unterminated)}.validate());
+
+        std::vector<std::byte> bad_ids = patch(slots + 4, 5);
+        std::memcpy(bad_ids.data() + slots + 8 + 4, bad_ids.data() + slots + 4, 4);
+        const std::zstring_table out_of_range{std::span<const std::byte>(bad_ids)};
+        CHECK(!out_of_range.validate());
+        CHECK(out_of_range.find("x") == out_of_range.npos);
+        CHECK(std::zstring_table{std::span<const std::byte>(valid)}.validate());
+    }
+
+    const std::string path = "/tmp/zstring_view_test_table_" + std::to_string(::getpid());
+    builder.write(std::zstring_view(path));
+    {
+        std::zstring_table file{std::zstring_view(path)};
+        CHECK(file[3] == "main");
+        CHECK(file.verify_checksum());
+        CHECK(file.find("resize") == 0);
+        const std::zstring_table moved = std::move(file);
+        CHECK(moved[0] == "resize");
+    }
+    ::unlink(path.c_str());
+
+    const std::vector<std::byte> empty_blob = std::zstring_table_builder().build();
+    const std::zstring_table empty{std::span<const std::byte>(empty_blob)};
+    CHECK(empty.empty());
+    CHECK(empty.find("a") == empty.npos);
+    CHECK(empty.verify_checksum());
+
+    for(unsigned seed = 0; seed < 200; seed++) {
+        round_trip<char>(seed);
+        round_trip<char16_t>(seed);
+        round_trip<char32_t>(seed);
+        round_trip<wchar_t>(seed);
+    }
+    return check::result();
+}
@@ -0,0 +1,170 @@
+#include "check.hpp"
+
+#include <zstring_transcode.hpp>
+
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// Random code points round-trip between every pair of encodings into spans and arenas, truncation stops on a code
+// point boundary, and malformed input reports the position of the first bad code unit
+
+using namespace std::literals;
+
+namespace {
+    template<class charT>
+    std::basic_string<charT> encode(const std::u32string& code_points) {
+        std::basic_string<charT> str;
+        for(const char32_t c : code_points) {
+            charT units[4];
+            std::__zsv::__encode(c, units);
+            str.append(units, std::__zsv::__encoded_length<charT>(c));
+        }
+        return str;
+    }
+
+    template<class To, class From>
+    void check_pair(const std::u32string& code_points) {
+        const std::basic_string<From> src = encode<From>(code_points);
+        const std::basic_string<To> expected = encode<To>(code_points);
+        const std::basic_zstring_view<From> view(src);
+
+        const auto length = std::transcoded_length<To>(view);
+        CHECK(length.ec == std::errc());
+        CHECK(length.size == expected.size());
+        CHECK(length.position == src.size());
+
+        std::vector<To> buffer(expected.size() + 1);
+        const auto result = std::transcode<To>(view, std::span<To>(buffer));
+        CHECK(result.ec == std::errc());
+        CHECK(result.str == std::basic_string_view<To>(expected));
+        CHECK(result.str.c_str()[result.str.size()] == To());
+
+        std::basic_zstring_arena<To> arena(64);
+        const auto stored = std::transcode<To>(view, arena);
+        CHECK(stored.ec == std::errc());
+        CHECK(stored.str == std::basic_string_view<To>(expected));
+
+        if(expected.size() > 2) {
+            std::vector<To> half(expected.size() / 2 + 1);
+            const auto truncated = std::transcode<To>(view, std::span<To>(half));
+            CHECK(truncated.ec == std::errc::value_too_large);
+            CHECK(truncated.str.size() < half.size());
+            CHECK(std::basic_string_view<To>(expected).starts_with(truncated.str));
+            // The rest of the input continues where the output stopped
+            const std::basic_string<From> rest = src.substr(truncated.position);
+            const auto continued = std::transcode<To>(std::basic_zstring_view<From>(rest), arena);
+            CHECK(continued.ec == std::errc());
+            CHECK(std::basic_string<To>(truncated.str) + std::basic_string<To>(continued.str) == expected);
+        }
+    }
+
+    template<class To>
+    void check_from_all(const std::u32string& code_points) {
+        check_pair<To, char>(code_points);
+        check_pair<To, char8_t>(code_points);
+        check_pair<To, char16_t>(code_points);
+        check_pair<To, char32_t>(code_points);
+        check_pair<To, wchar_t>(code_points);
+    }
+}
+
+static_assert([] {
+    char16_t buffer[8]{};
+    const auto result = std::transcode<char16_t>(std::u8zstring_view(u8"hé\U0001F600"), std::span<char16_t>(buffer));
+    return result.ec == std::errc() && result.str.size() == 4 && buffer[3] == 0xde00;
+}());
+static_assert(std::transcoded_length<char>(std::u16zstring_view(u"\U0001F600x")).size == 5);
+
+int main() {
+    std::mt19937 rng(1);
+    for(int i = 0; i < 400; i++) {
+        // Mostly ASCII, all ASCII, or ASCII runs with a few wider code points
+        const int mode = i % 4;
+        std::u32string code_points;
+        for(std::size_t n = rng() % 300; code_points.size() < n;) {
+            const std::uint32_t r = rng() % 100;
+            char32_t c;
+            if(mode == 0 || r < 70 || (mode == 3 && code_points.size() % 50 != 0)) {
+                c = rng() % 0x80;
+            } else if(r < 80) {
+                c = 0x80 + rng() % (0x800 - 0x80);
+            } else if(r < 90) {
+                do {
+                    c = 0x800 + rng() % (0x10000 - 0x800);
+                } while(c >= 0xd800 && c <= 0xdfff);
+            } else {
+                c = 0x10000 + rng() % (0x110000 - 0x10000);
+            }
+            code_points.push_back(c);
+        }
+        check_from_all<char>(code_points);
+        check_from_all<char8_t>(code_points);
+        check_from_all<char16_t>(code_points);
+        check_from_all<char32_t>(code_points);
+        check_from_all<wchar_t>(code_points);
+    }
+
+    const struct {
+        const char* str;
+        std::size_t position;
+    } malformed[] = {
+        {"ab\xc0\x80", 2}, {"\xc1\xbf", 0}, {"x\xe0\x80\x80", 1}, {"\xed\xa0\x80", 0}, {"\xf4\x90\x80\x80", 0},
+        {"\xf5\x80\x80\x80", 0}, {"abc\xe2\x82", 3}, {"\x80", 0}, {"\xe2\x28\xa1", 0}, {"\xf0\x9f\x98", 0},
+        {"ok\xf0\x9f\x98\x80\xff", 6},
+    };
+    for(const auto& input : malformed) {
+        const std::zstring_view view(input.str);
+        const auto length = std::transcoded_length<char16_t>(view);
+        CHECK(length.ec == std::errc::illegal_byte_sequence);
+        CHECK(length.position == input.position);
+        char16_t buffer[32];
+        const auto result = std::transcode<char16_t>(view, buffer);
+        CHECK(result.ec == std::errc::illegal_byte_sequence);
+        CHECK(result.position == input.position);
+        std::u16zstring_arena arena;
+        const auto stored = std::transcode<char16_t>(view, arena);
+        CHECK(stored.ec == std::errc::illegal_byte_sequence);
+        CHECK(stored.str.empty());
+        CHECK(arena.capacity() == 0);
+    }
+
+    char32_t code_point[4];
+    CHECK(std::transcode<char32_t>("\xf4\x8f\xbf\xbf"zsv, code_point).str == U"\U0010FFFF"sv);
+    CHECK(std::transcode<char32_t>("\xef\xbf\xbf"zsv, code_point).str == U"\uFFFF"sv);
+
+    const char16_t lone_lead[] = {u'a', 0xd800, u'b', 0};
+    const auto lone = std::transcoded_length<char8_t>(std::u16zstring_view(lone_lead));
+    CHECK(lone.ec == std::errc::illegal_byte_sequence);
+    CHECK(lone.position == 1);
+    CHECK(lone.size == 1);
+    const char16_t lone_trail[] = {0xdc00, 0};
+    CHECK(std::transcoded_length<char8_t>(std::u16zstring_view(lone_trail)).ec == std::errc::illegal_byte_sequence);
+    const char16_t final_lead[] = {u'x', 0xdbff, 0};
+    CHECK(std::transcoded_length<char8_t>(std::u16zstring_view(final_lead)).position == 1);
+    const char32_t too_large[] = {0x110000, 0};
+    CHECK(std::transcoded_length<char>(std::u32zstring_view(too_large)).ec == std::errc::illegal_byte_sequence);
+    const char32_t surrogate[] = {0xdfff, 0};
+    CHECK(std::transcoded_length<char>(std::u32zstring_view(surrogate)).ec == std::errc::illegal_byte_sequence);
+
+    // Output that a deduplicating arena already holds doesn't take arena storage again
+    std::u16zstring_arena deduplicating(64, true);
+    const std::string long_input(200, 'q');
+    const auto once = std::transcode<char16_t>(std::zstring_view(long_input), deduplicating);
+    CHECK(once.str == std::u16string(200, u'q'));
+    const std::size_t capacity = deduplicating.capacity();
+    for(int i = 0; i < 10; i++) {
+        CHECK(std::transcode<char16_t>(std::zstring_view(long_input), deduplicating).str.data() == once.str.data());
+    }
+    CHECK(deduplicating.capacity() == capacity);
+
+    const std::string embedded("a\0b", 3);
+    char16_t wide[8];
+    const auto kept = std::transcode<char16_t>(std::zstring_view(embedded), wide);
+    CHECK(kept.str.size() == 3);
+    CHECK(kept.str[1] == u'\0');
+    return check::result();
+}
@@ -0,0 +1,99 @@
+#include "check.hpp"
+
+#include <zstring_view.hpp>
+
+#include <format>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The length scan and find kernels against basic_string_view, at every alignment and around the vector widths, and
+// the tail operations that keep the zstring_view type
+
+using namespace std::literals;
+
+namespace {
+    template<class charT>
+    void check_length() {
+        for(std::size_t offset = 0; offset < 16; offset++) {
+            for(std::size_t n = 0; n < 200; n++) {
+                std::vector<charT> buffer(n + 64, charT('a'));
+                buffer[offset + n] = charT();
+                CHECK(std::basic_zstring_view<charT>(buffer.data() + offset).size() == n);
+            }
+        }
+    }
+
+    template<class charT>
+    void check_find() {
+        std::mt19937 rng(1);
+        for(int iteration = 0; iteration < 20000; iteration++) {
+            const std::size_t n = rng() % 150;
+            const std::size_t offset = rng() % 8;
+            std::vector<charT> buffer(offset + n + 1);
+            for(std::size_t i = 0; i < n; i++) {
+                const unsigned r = rng() % 10;
+                // Embedded nulls, and code units that only differ above the low byte
+                buffer[offset + i] = r == 0 ? charT() : charT('a' + r + (sizeof(charT) > 1 && rng() % 50 == 0 ? 300 : 0));
+            }
+            const std::basic_zstring_view<charT> z(buffer.data() + offset, n);
+            const std::basic_string_view<charT> s(buffer.data() + offset, n);
+            const std::size_t pos = rng() % (n + 3);
+            const charT c = rng() % 7 == 0 ? charT() : charT('a' + rng() % 10);
+            CHECK(z.find(c, pos) == s.find(c, pos));
+            CHECK(z.rfind(c, pos) == s.rfind(c, pos));
+            CHECK(z.contains(c) == s.contains(c));
+            CHECK(z.find_first_not_of(c, pos) == s.find_first_not_of(c, pos));
+            const charT set[] = {charT('a' + rng() % 10), charT('a' + rng() % 10), charT(), charT('d')};
+            const std::basic_string_view<charT> chars(set, rng() % 5);
+            CHECK(z.find_first_of(chars, pos) == s.find_first_of(chars, pos));
+            CHECK(z.find_first_not_of(chars, pos) == s.find_first_not_of(chars, pos));
+        }
+    }
+
+    void check_tails() {
+        const std::zstring_view path = "/usr/lib/libm.so";
+        CHECK(path.zsubstr(5) == "lib/libm.so");
+        CHECK(path.zsubstr(5).c_str()[path.size() - 5] == '\0');
+        CHECK(path.zsubstr(path.size()).empty());
+        CHECK_THROWS(std::out_of_range, (void)path.zsubstr(path.size() + 1));
+        CHECK(path.after_first('/') == "usr/lib/libm.so");
+        CHECK(path.after_last('.') == "so");
+        CHECK(!path.after_first('x'));
+        CHECK(path.strip_prefix("/usr/") == "lib/libm.so");
+        CHECK(!path.strip_prefix("/lib/"));
+        CHECK(path.basename() == "libm.so");
+        CHECK("plain"zsv.basename() == "plain");
+        CHECK("dir/"zsv.basename().empty());
+    }
+}
+
+static_assert("abc"zsv.find('b') == 1);
+static_assert("abc"zsv.find_first_of("cb") == 1);
+static_assert(std::zstring_view("abc").size() == 3);
+static_assert(u"a/b"zsv.basename() == u"b");
+
+int main() {
+    check_length<char>();
+    check_length<char16_t>();
+    check_length<char32_t>();
+    check_length<wchar_t>();
+    check_find<char>();
+    check_find<char8_t>();
+    check_find<char16_t>();
+    check_find<char32_t>();
+    check_find<wchar_t>();
+    check_tails();
+
+    CHECK(std::format("[{:>6}]", "xy"zsv) == "[    xy]");
+    CHECK(std::format(L"[{:^5}]", L"ab"zsv) == L"[ ab  ]");
+    const std::string owner = "owned";
+    const std::zstring_view from_string = owner;
+    CHECK(from_string.c_str() == owner.c_str());
+    // The terminator is part of the accessible range
+    CHECK(from_string.at(5) == '\0');
+    CHECK_THROWS(std::out_of_range, (void)from_string.at(6));
+    return check::result();
+}
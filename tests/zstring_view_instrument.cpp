@@ -0,0 +1,62 @@
+#include "check.hpp"
+
+#include <zstring_view.hpp>
+
+#include <cstdint>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace std::literals;
+
+// Built with ZSTRING_VIEW_INSTRUMENT: costs are counted against the line that caused them
+
+#ifndef ZSTRING_VIEW_INSTRUMENT
+#error "this test must be built with ZSTRING_VIEW_INSTRUMENT"
+#endif
+
+namespace {
+    const std::uint_least32_t measure_line = std::source_location::current().line() + 1;
+    std::size_t measure(const char* str) { return std::zstring_view(str).size(); }
+
+    const std::zstring_view_call_site* find_site(std::uint_least32_t line) {
+        static std::vector<std::zstring_view_call_site> sites;
+        sites = std::zstring_view_call_sites();
+        for(const auto& site : sites) {
+            if(site.line == line) {
+                return &site;
+            }
+        }
+        return nullptr;
+    }
+}
+
+int main() {
+    const std::string str(100, 'x');
+    for(int i = 0; i < 10; i++) {
+        measure(str.c_str());
+    }
+    const std::uint_least32_t view_line = std::source_location::current().line() + 1;
+    const std::zstring_view view = str;
+    for(int i = 0; i < 3; i++) {
+        const std::string_view converted = view;
+        (void)converted;
+    }
+    const std::uint_least32_t at_line = std::source_location::current().line() + 1;
+    CHECK_THROWS(std::out_of_range, (void)view.at(1000));
+
+    const std::zstring_view_call_site* scans = find_site(measure_line);
+    CHECK(scans && scans->length_scans == 10 && scans->bytes_scanned == 1010);
+    const std::zstring_view_call_site* conversions = find_site(view_line);
+    CHECK(conversions && conversions->conversions == 3 && conversions->length_scans == 0);
+    const std::zstring_view_call_site* throws = find_site(at_line);
+    CHECK(throws && throws->at_throws == 1);
+
+    // Literals are counted against an unknown site, not against the literal operator in the header
+    const std::string_view literal = "literal"zsv;
+    CHECK(literal.size() == 7);
+    const std::zstring_view_call_site* unknown = find_site(0);
+    CHECK(unknown && unknown->conversions == 1 && unknown->file[0] == '\0');
+    return check::result();
+}